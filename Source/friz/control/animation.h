@@ -23,8 +23,11 @@
 
 // #include "../animatorApp.h"
 #include <array>
+#include <utility>
+#include <juce_gui_basics/juce_gui_basics.h>
 
 #include "../curves/animatedValue.h"
+#include "../curves/sharedCurve.h"
 
 namespace friz
 {
@@ -44,6 +47,17 @@ public:
         finished    ///< Finished running, okay to clean up.
     };
 
+    /**
+     * @brief How important it is to keep this animation running smoothly
+     * when the `Animator` is over its frame budget (see `Animator::setFrameBudget()`)
+     */
+    enum class Priority
+    {
+        low,    ///< Degraded first (e.g. ambient or decorative effects)
+        normal, ///< Degraded only if degrading low priority animations wasn't enough.
+        high    ///< Always updated on every frame (e.g. following user interaction)
+    };
+
     AnimationType (int id)
     : animationId { id }
     , preDelay { 0 }
@@ -65,6 +79,161 @@ public:
      */
     void setDelay (int delay) { preDelay = std::max (0, delay); }
 
+    /**
+     * @return the pre-delay before this animation starts executing.
+     */
+    int getDelay () const { return preDelay; }
+
+    /**
+     * @param newPriority see `Priority`
+     */
+    void setPriority (Priority newPriority) { priority = newPriority; }
+
+    /**
+     * @return the priority of this animation.
+     */
+    Priority getPriority () const { return priority; }
+
+    /**
+     * @brief Tags let the `Animator` operate on whole sets of animations at
+     * once (e.g. everything owned by one panel.) Each bit of the mask is a tag,
+     * and an animation may have any number of them. The animator indexes our
+     * tags when we're added to it, so they can't be changed after that.
+     *
+     * @param newTags bit mask of tags.
+     */
+    void setTags (juce::uint32 newTags)
+    {
+        if (tagsIndexed)
+        {
+            jassertfalse;
+            return;
+        }
+        tags = newTags;
+    }
+
+    /**
+     * @return our bit mask of tags.
+     */
+    juce::uint32 getTags () const { return tags; }
+
+    /**
+     * @brief Run this animation faster or slower than the clock that drives
+     * it (e.g. 2.0 for double speed); changes take effect smoothly from the
+     * current time. Only used for animations that are added directly to an
+     * `Animator` (not those inside a `Chain`, `Group`, etc.), and not in
+     * timeline mode.
+     *
+     * @param scale multiplier for the rate of our clock, >= 0.
+     */
+    void setTimeScale (float scale)
+    {
+        jassert (scale >= 0.f);
+        timeScale = std::max (0.f, scale);
+        markClockChanged ();
+    }
+
+    /**
+     * @return our time scale.
+     */
+    float getTimeScale () const { return timeScale; }
+
+    /**
+     * @brief Freeze this animation where it is; the `Animator` won't update it
+     * until it's resumed, and it continues from where it was.
+     *
+     * @param shouldPause
+     */
+    void setPaused (bool shouldPause)
+    {
+        paused = shouldPause;
+        markClockChanged ();
+    }
+
+    /**
+     * @return true if we're paused.
+     */
+    bool isPaused () const { return paused; }
+
+    /**
+     * @return true if our clock doesn't run in step with the one that drives
+     * us, because we're paused or have a time scale other than 1.
+     */
+    bool hasOwnClock () const { return paused || timeScale != 1.f; }
+
+    /**
+     * @brief Check (and clear) whether our time scale or paused state has been
+     * set since the last time this was called.
+     */
+    bool takeClockChange () { return std::exchange (clockChanged, false); }
+
+    /**
+     * @brief Advance our own clock by the time since our last update, scaled
+     * by our time scale (and not at all while we're paused). The `Animator`
+     * calls this and passes the result to `gotoTime()`.
+     *
+     * @param timeInMs time on the clock that drives us.
+     * @return the time on our own clock.
+     */
+    juce::int64 advanceLocalClock (juce::int64 timeInMs)
+    {
+        if (lastOuterTime < 0)
+            localTime = static_cast<double> (timeInMs);
+        else if (!paused)
+            localTime += static_cast<double> (timeInMs - lastOuterTime) * timeScale;
+
+        lastOuterTime = timeInMs;
+        return static_cast<juce::int64> (localTime);
+    }
+
+    /**
+     * @brief Convert a time on the clock that drives us to our own clock,
+     * without advancing it.
+     */
+    juce::int64 toLocalTime (juce::int64 timeInMs) const
+    {
+        if (lastOuterTime < 0)
+            return timeInMs;
+        if (paused)
+            return static_cast<juce::int64> (localTime);
+        return static_cast<juce::int64> (
+            localTime + static_cast<double> (timeInMs - lastOuterTime) * timeScale);
+    }
+
+    /**
+     * @brief Tie this animation to the component that it moves. The `Animator`
+     * won't update us while the component isn't visible on screen (it's hidden,
+     * its window is minimized, or it's been scrolled or clipped out of its
+     * parents' bounds), and we'll catch up to the current time as soon as it's
+     * back. If the component is deleted, the animation is canceled.
+     *
+     * Bound animations must be driven from the message thread.
+     *
+     * @param component
+     */
+    void bindComponent (juce::Component* component)
+    {
+        boundComponent = component;
+        bound          = component != nullptr;
+    }
+
+    /**
+     * @return true if `bindComponent()` has been called with a component.
+     */
+    bool isBound () const { return bound; }
+
+    /**
+     * @return the bound component, or nullptr if there isn't one (or if it
+     * has been deleted.)
+     */
+    juce::Component* getBoundComponent () const { return boundComponent.getComponent (); }
+
+    /**
+     * @return true once we have a start time, either from our first update or
+     * from `setStartTime()`
+     */
+    bool hasStarted () const { return startTime >= 0; }
+
     virtual bool setValue (size_t /*index*/, std::unique_ptr<AnimatedValue> /*value*/)
     {
         jassertfalse;
@@ -106,6 +275,86 @@ public:
      * @return AnimatedValue*
      */
     virtual AnimatedValue* getValue (size_t index) = 0;
+
+    /**
+     * @brief Change the end value of one of our values while it's running.
+     * Not all animated value classes support this.
+     *
+     * @param index index of the value.
+     * @param newTarget
+     * @return true if the value accepted its new target.
+     */
+    virtual bool updateTarget (size_t index, float newTarget)
+    {
+        auto* value { getValue (index) };
+        return value != nullptr && value->updateTarget (newTarget);
+    }
+
+    /**
+     * @brief Call a function for each of the AnimatedValue objects owned by this
+     * animation (including those owned by any child animations).
+     *
+     * @param visitor
+     */
+    virtual void visitValues (const std::function<void (AnimatedValue&)>& /*visitor*/) {}
+
+    /**
+     * @brief Calculate this animation's values at a point in time without
+     * sending them to an update callback, so a component can pull exactly the
+     * values it needs when it paints.
+     *
+     * @param timeInMs   Time on the same clock that's used to call `gotoTime()`
+     * @param values     array to fill, at least `valueCount` long.
+     * @param valueCount number of values the caller is expecting.
+     * @return true if this animation supports sampling and the values were written.
+     */
+    virtual bool sample (juce::int64 /*timeInMs*/, float* /*values*/,
+                         size_t /*valueCount*/)
+    {
+        return false;
+    }
+
+    /**
+     * @brief Go directly to a point in time, which may be earlier than the
+     * last time we were updated, sending value updates as `gotoTime()` does.
+     * The `Animator` uses this in timeline mode to scrub back and forth.
+     *
+     * @param timeInMs Time on the same clock that's used to call `gotoTime()`
+     * @return Status, `finished` if the animation is complete at this time.
+     */
+    virtual Status seek (juce::int64 timeInMs) { return gotoTime (timeInMs); }
+
+    /**
+     * @return the total running time of this animation in ms (including any
+     * pre-delay), or -1 if that can't be known in advance, e.g. because it
+     * uses physics-style values that run until they settle.
+     */
+    virtual juce::int64 getDuration () const { return -1; }
+
+    /**
+     * @brief Fix the time that this animation starts at, instead of starting
+     * at the time of its first update. Any pre-delay is counted from here.
+     *
+     * @param timeInMs
+     */
+    void setStartTime (juce::int64 timeInMs) { startTime = lastTime = timeInMs; }
+
+    /**
+     * @brief Once this animation is finished, find the time that it finished at.
+     * If our duration is known in advance, this is exact, even if it fell
+     * partway through a frame; otherwise, it's the time of the update where
+     * we finished.
+     *
+     * @return juce::int64 time on the same clock that's used to call `gotoTime()`
+     */
+    juce::int64 getFinishTime () const
+    {
+        const auto duration { getDuration () };
+        if (startTime >= 0 && duration >= 0)
+            return startTime + duration;
+        return lastTime;
+    }
+
     /**
      * @brief callback on completion of this effect
      * @param int id -- ID of this animation.
@@ -121,16 +370,170 @@ public:
      */
     void onCompletion (CompletionFn complete) { completionFn = complete; }
 
+    /**
+     * @brief If completion is deferred, the completion callback isn't executed
+     * from inside `gotoTime()` or `cancel()`; it's held until
+     * `sendDeferredCompletion()` is called. The realtime mode of the `Animator`
+     * uses this to execute completion callbacks on the message thread.
+     *
+     * @param shouldDefer
+     */
+    virtual void setCompletionDeferred (bool shouldDefer) { completionDeferred = shouldDefer; }
+
+    /**
+     * @return true if our completion callback is held until `sendDeferredCompletion()`
+     */
+    bool isCompletionDeferred () const { return completionDeferred; }
+
+    /**
+     * @brief Execute a completion callback that was held because completion is
+     * deferred. Does nothing if there's no pending completion. Container
+     * animations send their children's completions first.
+     */
+    virtual void sendDeferredCompletion ()
+    {
+        if (completionPending)
+        {
+            completionPending = false;
+            if (completionFn != nullptr)
+                completionFn (getId (), pendingWasCanceled);
+        }
+    }
+
 public:
     /// function to call when the animation is completed or canceled.
     CompletionFn completionFn;
 
+protected:
+    /**
+     * @brief Derived classes call this (instead of calling `completionFn`
+     * directly) when the animation completes or is canceled.
+     *
+     * @param wasCanceled
+     */
+    void notifyCompletion (bool wasCanceled)
+    {
+        if (completionDeferred)
+        {
+            completionPending  = true;
+            pendingWasCanceled = wasCanceled;
+        }
+        else if (completionFn != nullptr)
+            completionFn (getId (), wasCanceled);
+    }
+
+    /**
+     * @brief Keep track of when we started and when we were last updated, and
+     * calculate how far into the effect we are.
+     *
+     * @param timeInMs      time passed to `gotoTime()`
+     * @param effectElapsed time since the effect started (after any pre-delay)
+     * @param deltaTime     time since our last update.
+     * @return false if we're still waiting for the pre-delay to expire.
+     */
+    bool advanceClock (juce::int64 timeInMs, juce::int64& effectElapsed,
+                       juce::int64& deltaTime)
+    {
+        // if this is the first time we're being executed, perform some setup:
+        if (startTime < 0)
+        {
+            startTime = lastTime = timeInMs;
+            deltaTime            = 0;
+        }
+        else
+        {
+            deltaTime = timeInMs - lastTime;
+            lastTime  = timeInMs;
+        }
+
+        const auto totalElapsed { timeInMs - startTime };
+
+        if (totalElapsed < preDelay)
+            return false;
+
+        // recalculate the elapsed and delta times to account for an
+        // expired delay
+        effectElapsed = totalElapsed - preDelay;
+        deltaTime     = std::min (deltaTime, effectElapsed);
+        return true;
+    }
+
+    /**
+     * @brief Calculate how far into the effect we'd be at a point in time,
+     * without changing any state.
+     *
+     * @param timeInMs
+     * @return juce::int64 elapsed ms, 0 if we haven't started yet or are still
+     * in the pre-delay.
+     */
+    juce::int64 getEffectElapsed (juce::int64 timeInMs) const
+    {
+        if (startTime < 0)
+            return 0;
+
+        return std::max (juce::int64 { 0 }, timeInMs - startTime - preDelay);
+    }
+
 protected:
     /// optional ID value for this animation.
     int animationId { 0 };
 
     /// an optional pre-delay before beginning to execute the effect.
     int preDelay { 0 };
+
+    /// @brief how this animation is treated when the animator is over budget.
+    Priority priority { Priority::normal };
+
+    /// @brief bit mask of tags.
+    juce::uint32 tags { 0 };
+
+    /// @brief rate of our clock relative to the one that drives us.
+    float timeScale { 1.f };
+    /// @brief don't advance our clock?
+    bool paused { false };
+    /// @brief has our time scale or paused state been set since we were last checked?
+    bool clockChanged { false };
+    /// @brief current time on our own clock.
+    double localTime { 0.0 };
+    /// @brief time of the clock that drives us at our last update, or -1.
+    juce::int64 lastOuterTime { -1 };
+
+    /// @brief the component we animate, if we've been bound to one.
+    juce::Component::SafePointer<juce::Component> boundComponent;
+    /// @brief were we bound? (lets us tell if the component was deleted.)
+    bool bound { false };
+
+    /// @brief Timestamp of first update.
+    juce::int64 startTime { -1 };
+    /// @brief timestamp of most recent update.
+    juce::int64 lastTime { -1 };
+
+private:
+    friend class Animator;
+
+    /// @brief has an `Animator` added us to its tag index?
+    bool tagsIndexed { false };
+    /// @brief our position in the animator's list for each of our tags, in bit order.
+    std::vector<size_t> tagSlots;
+    /// @brief canceled by tag; the animator will drop us without another update.
+    bool retired { false };
+    /// @brief if set, where to list ourselves when our clock changes, so an
+    /// animator using batched physics can take our values back.
+    std::vector<AnimationType*>* clockChanges { nullptr };
+
+    void markClockChanged ()
+    {
+        if (!clockChanged && clockChanges != nullptr)
+            clockChanges->push_back (this);
+        clockChanged = true;
+    }
+
+    /// @brief Hold completion callbacks until `sendDeferredCompletion()`?
+    bool completionDeferred { false };
+    /// @brief Is there a deferred completion waiting to be sent?
+    bool completionPending { false };
+    /// @brief canceled flag for the pending completion.
+    bool pendingWasCanceled { false };
 };
 
 template <std::size_t ValueCount> class UpdateSource
@@ -229,6 +632,31 @@ public:
         return nullptr;
     }
 
+    /**
+     * @brief Take ownership of one of this animation's value objects, leaving
+     * its slot empty.
+     *
+     * @param index
+     * @return std::unique_ptr<AnimatedValue>
+     */
+    std::unique_ptr<AnimatedValue> releaseValue (size_t index)
+    {
+        if (index < ValueCount)
+            return std::move (sources[index]);
+
+        jassertfalse;
+        return nullptr;
+    }
+
+    void visitValues (const std::function<void (AnimatedValue&)>& visitor) override
+    {
+        for (auto& src : sources)
+        {
+            if (src != nullptr)
+                visitor (*src);
+        }
+    }
+
     /**
      * @brief Advance to the specified time, sending value updates to the
      * code that's waiting for them.
@@ -240,34 +668,27 @@ public:
     {
         if (finished)
         {
-            if (completionFn != nullptr)
-                completionFn (getId (), false);
+            notifyCompletion (false);
             return Status::finished;
         }
 
+        juce::int64 effectElapsed;
         juce::int64 deltaTime;
-        // if this is the first time we're being executed, perform some setup:
-        if (startTime < 0)
-        {
-            startTime = lastTime = timeInMs;
-            deltaTime            = 0;
-        }
-        else
-        {
-            deltaTime = timeInMs - lastTime;
-            lastTime  = timeInMs;
-        }
-
-        const auto totalElapsed { timeInMs - startTime };
-
         // if we're still delaying, just return.
-        if (totalElapsed < preDelay)
+        if (!advanceClock (timeInMs, effectElapsed, deltaTime))
             return Status::processing;
 
-        // recalculate the elapsed and delta times to account for an
-        // expired delay
-        const auto effectElapsed { totalElapsed - preDelay };
-        deltaTime = std::min (deltaTime, totalElapsed);
+        // If nobody is listening for pushed updates and all of our values can
+        // be sampled on demand, all we need to track here is whether we're done.
+        if (this->updateFn == nullptr && canSampleAll ())
+        {
+            for (auto& src : sources)
+                src->setElapsed (static_cast<int> (effectElapsed));
+
+            if (effectElapsed >= getLongestDuration ())
+                finished = true;
+            return Status::processing;
+        }
 
         // loop through our value generators and update:
         ValueList values;
@@ -320,8 +741,7 @@ public:
         }
 
         // notify that the effect is complete.
-        if (completionFn != nullptr)
-            completionFn (getId (), true);
+        notifyCompletion (true);
         finished = true;
     }
 
@@ -337,13 +757,118 @@ public:
         return true;
     }
 
-public:
+    /**
+     * @brief Calculate all of our values at a point in time without advancing
+     * or changing the state of the animation. Only animations whose values are all
+     * time-based (e.g. `Linear`, `Parametric`, `Sinusoid`) can be sampled.
+     *
+     * Before the animation has started running (or while it's in its pre-delay),
+     * this returns the starting values.
+     *
+     * @param timeInMs Time on the same clock that's used to call `gotoTime()`
+     * @param values array to fill with the calculated values.
+     * @return false if any of our values can't be sampled.
+     */
+    bool valueAt (juce::int64 timeInMs, ValueList& values)
+    {
+        if (!canSampleAll ())
+            return false;
+
+        const auto effectElapsed { static_cast<int> (getEffectElapsed (timeInMs)) };
+
+        for (size_t i = 0; i < ValueCount; ++i)
+            values[i] = sources[i]->valueAt (effectElapsed);
+
+        return true;
+    }
+
+    bool sample (juce::int64 timeInMs, float* values, size_t valueCount) override
+    {
+        if (valueCount < ValueCount)
+        {
+            jassertfalse;
+            return false;
+        }
+
+        ValueList sampled;
+        if (!valueAt (timeInMs, sampled))
+            return false;
+
+        std::copy (sampled.begin (), sampled.end (), values);
+        return true;
+    }
+
+    Status seek (juce::int64 timeInMs) override
+    {
+        if (startTime < 0)
+            setStartTime (timeInMs);
+        lastTime = timeInMs;
+
+        const auto effectElapsed { static_cast<int> (getEffectElapsed (timeInMs)) };
+
+        ValueList values;
+        bool allFinished { true };
+        for (size_t i = 0; i < ValueCount; ++i)
+        {
+            auto& val = sources[i];
+            jassert (val != nullptr);
+            if (val != nullptr)
+            {
+                values[i]   = val->seek (effectElapsed);
+                allFinished = allFinished && val->isFinished ();
+            }
+        }
+
+        if (this->updateFn != nullptr)
+            this->updateFn (getId (), values);
+
+        // notify each time we cross the end moving forward.
+        if (allFinished && !finished)
+            notifyCompletion (false);
+        finished = allFinished;
+
+        return finished ? Status::finished : Status::processing;
+    }
+
+    juce::int64 getDuration () const override
+    {
+        for (auto& src : sources)
+        {
+            if (src == nullptr || src->getDuration () < 0)
+                return -1;
+        }
+        return preDelay + getLongestDuration ();
+    }
+
 private:
-    /// @brief Timestamp of first update.
-    juce::int64 startTime { -1 };
-    /// @brief timestamp of most recent update.
-    juce::int64 lastTime { -1 };
+    /**
+     * @return true if all of our values can be evaluated statelessly.
+     */
+    bool canSampleAll () const
+    {
+        for (auto& src : sources)
+        {
+            if (src == nullptr || !src->canSample ())
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @return the duration in ms of our longest-running value.
+     */
+    int getLongestDuration () const
+    {
+        int longest { 0 };
+        for (auto& src : sources)
+        {
+            if (src != nullptr)
+                longest = std::max (longest, src->getDuration ());
+        }
+        return longest;
+    }
 
+private:
     /// is this animation complete?
     bool finished { false };
 
@@ -394,4 +919,43 @@ std::unique_ptr<Animation<1>> makeAnimation (int id, float from, float to, Args.
     return makeAnimation<T, 1> (id, { from }, { to }, std::forward<Args> (args)...);
 }
 
+/**
+ * @brief Factory function to create a set of animations that all follow the
+ * same curve, each one starting `staggerMs` after the one before it (e.g. to
+ * animate the items in a list). All of the values share a single `CurveSpec`;
+ * the stagger is each animation's pre-delay.
+ *
+ * @tparam ValueCount number of data values used in each animation.
+ * @param spec      curve for all of the values to follow.
+ * @param count     number of animations to create.
+ * @param firstId   ID of the first animation; the others are numbered sequentially.
+ * @param from      starting values for each animation.
+ * @param to        ending values for each animation.
+ * @param staggerMs delay between the starts of successive animations.
+ * @return std::vector<std::unique_ptr<Animation<ValueCount>>> the animations, ready
+ *         for you to set their update functions and add them to an `Animator`.
+ */
+template <std::size_t ValueCount>
+std::vector<std::unique_ptr<Animation<ValueCount>>>
+makeStaggeredAnimations (const CurveSpec::Ptr& spec, int count, int firstId,
+                         const std::array<float, ValueCount>& from,
+                         const std::array<float, ValueCount>& to, int staggerMs)
+{
+    std::vector<std::unique_ptr<Animation<ValueCount>>> animations;
+    animations.reserve (static_cast<size_t> (std::max (0, count)));
+
+    for (int i { 0 }; i < count; ++i)
+    {
+        auto animation { std::make_unique<Animation<ValueCount>> (firstId + i) };
+        for (size_t v { 0 }; v < ValueCount; ++v)
+            animation->setValue (v, std::make_unique<SharedCurve> (spec, from[v], to[v]));
+
+        animation->setDelay (i * staggerMs);
+
+        animations.push_back (std::move (animation));
+    }
+
+    return animations;
+}
+
 } // namespace friz
@@ -24,6 +24,146 @@
 namespace friz
 {
 
+namespace
+{
+#if JUCE_DEBUG
+/// set while a realtime animator is updating on the current thread.
+thread_local bool inRealtimeUpdate { false };
+#endif
+
+/**
+ * @brief Is any part of a component visible on screen? It must be showing,
+ * and not clipped out of the bounds of any of its parents (e.g. scrolled out
+ * of a viewport.)
+ */
+bool isComponentOnScreen (const juce::Component& component)
+{
+    if (!component.isShowing ())
+        return false;
+
+    auto area { component.getLocalBounds () };
+    for (auto* child { &component }; auto* parent { child->getParentComponent () };
+         child = parent)
+    {
+        area = parent->getLocalArea (child, area).getIntersection (parent->getLocalBounds ());
+        if (area.isEmpty ())
+            return false;
+    }
+    return true;
+}
+} // namespace
+
+class Animator::RealtimeQueues : public juce::Timer,
+                                  private juce::AsyncUpdater
+{
+public:
+    /**
+     * @brief A single-producer, single-consumer FIFO of animation pointers.
+     * Ownership of an animation travels with its pointer.
+     */
+    class Queue
+    {
+    public:
+        Queue (int capacity)
+        : fifo { capacity + 1 }
+        , slots (static_cast<size_t> (capacity + 1), nullptr)
+        {
+        }
+
+        bool push (AnimationType* animation)
+        {
+            int start1, size1, start2, size2;
+            fifo.prepareToWrite (1, start1, size1, start2, size2);
+            if (size1 + size2 < 1)
+                return false;
+
+            slots[static_cast<size_t> (size1 > 0 ? start1 : start2)] = animation;
+            fifo.finishedWrite (1);
+            return true;
+        }
+
+        AnimationType* pop ()
+        {
+            int start1, size1, start2, size2;
+            fifo.prepareToRead (1, start1, size1, start2, size2);
+            if (size1 + size2 < 1)
+                return nullptr;
+
+            auto* animation { slots[static_cast<size_t> (size1 > 0 ? start1 : start2)] };
+            fifo.finishedRead (1);
+            return animation;
+        }
+
+        bool isEmpty () const { return fifo.getNumReady () == 0; }
+
+    private:
+        juce::AbstractFifo fifo;
+        std::vector<AnimationType*> slots;
+    };
+
+    RealtimeQueues (int capacity)
+    : incoming { capacity }
+    , outgoing { capacity }
+    {
+    }
+
+    ~RealtimeQueues () override
+    {
+        cancelPendingUpdate ();
+        stopTimer ();
+        timerCallback ();
+
+        while (auto* animation { incoming.pop () })
+            delete animation;
+    }
+
+    /**
+     * @brief Hand an animation over to the realtime thread. Called from the
+     * (single) thread that adds animations.
+     *
+     * @return false if the incoming queue is full.
+     */
+    bool add (AnimationType* animation)
+    {
+        if (!incoming.push (animation))
+            return false;
+
+        // we only need to check for retired animations while some are alive;
+        // the timer is started and stopped on the message thread.
+        if (alive.fetch_add (1) == 0)
+            triggerAsyncUpdate ();
+        return true;
+    }
+
+    void timerCallback () override
+    {
+        while (auto* animation { outgoing.pop () })
+        {
+            std::unique_ptr<AnimationType> retired { animation };
+            retired->sendDeferredCompletion ();
+            --alive;
+        }
+
+        if (alive.load () == 0)
+            stopTimer ();
+    }
+
+    void handleAsyncUpdate () override
+    {
+        if (alive.load () > 0 && !isTimerRunning ())
+            startTimerHz (30);
+    }
+
+    /// @brief added on another thread, waiting to be picked up by the realtime thread.
+    Queue incoming;
+    /// @brief finished on the realtime thread, waiting to be notified & deleted.
+    Queue outgoing;
+
+private:
+    /// @brief number of animations added that haven't been deleted yet.
+    std::atomic<int> alive { 0 };
+};
+
 Animator::Animator (std::unique_ptr<Controller> controller_)
 {
     if (controller_ != nullptr)
@@ -73,7 +213,57 @@ float Animator::getFrameRate () const
 void Animator::gotoTime (juce::int64 timeInMs)
 {
     int finishedCount { 0 };
-    juce::ScopedLock lock { mutex };
+    const Lock lock { *this };
+#if JUCE_DEBUG
+    const juce::ScopedValueSetter<bool> realtimeScope { inRealtimeUpdate, isRealtime () };
+#endif
+
+    if (isRealtime ())
+        acceptIncoming ();
+
+    if (paused)
+        return;
+
+    if (timeline)
+    {
+        if (frameBeginFn != nullptr)
+            frameBeginFn (timeInMs);
+
+        // finished animations stay on the timeline; only those canceled by tag
+        // need to be removed.
+        animations.erase (std::remove_if (animations.begin (), animations.end (),
+                                          [] (const std::unique_ptr<AnimationType>& c)
+                                          { return c->retired; }),
+                          animations.end ());
+        for (auto& animation : animations)
+            animation->seek (timeInMs);
+
+        if (frameEndFn != nullptr)
+            frameEndFn (timeInMs);
+        return;
+    }
+
+    timeInMs = advanceAnimationClock (timeInMs);
+    if (frameBeginFn != nullptr)
+        frameBeginFn (timeInMs);
+
+    if (!integrator.isEmpty ())
+    {
+        if (!clockChanges.empty ())
+            detachOwnClocks ();
+        if (integratorTime >= 0 && timeInMs > integratorTime)
+            integrator.advance (static_cast<int> (timeInMs - integratorTime));
+    }
+    integratorTime = timeInMs;
+
+    if (!arriving.empty () || !delayed.empty ())
+        startDelayed (timeInMs);
+
+    const auto budgeted { frameBudget > 0.0 };
+    const auto startTicks { budgeted ? juce::Time::getHighResolutionTicks () : 0 };
+    const auto reducedFrame { degradeLevel > 0 && (++frameCount % reducedRateDivisor) != 0 };
+    if (degradeLevel > 0)
+        ++budgetStats.framesDegraded;
 
     // for (auto& animation : animations)
     for (int i { 0 }; i < animations.size (); ++i)
@@ -81,12 +271,154 @@ void Animator::gotoTime (juce::int64 timeInMs)
         auto& animation { animations[i] };
         if (animation.get () != nullptr)
         {
-            if (AnimationType::Status::finished == animation->gotoTime (timeInMs))
+            if (updateAnimation (*animation, timeInMs, reducedFrame))
                 ++finishedCount;
         }
     }
     if (finishedCount > 0)
         cleanup ();
+
+    if (budgeted)
+        updateDegradeLevel (1000.0 * juce::Time::highResolutionTicksToSeconds (
+                                         juce::Time::getHighResolutionTicks () - startTicks));
+
+    if (!completions.empty ())
+    {
+        sendCompletions ();
+        // we may only have been running to send completions from a cancel.
+        if (!isRealtime () && animations.empty () && arriving.empty () && delayed.empty ())
+            controller->stop ();
+    }
+
+    if (frameEndFn != nullptr)
+        frameEndFn (timeInMs);
+}
+
+bool Animator::updateAnimation (AnimationType& animation, juce::int64 timeInMs,
+                                bool reducedFrame)
+{
+    // canceled by tag; it's already been reported.
+    if (animation.retired)
+        return true;
+
+    // keep the animation's own clock moving, even if we skip it below.
+    timeInMs = animation.advanceLocalClock (timeInMs);
+    if (animation.isPaused ())
+        return false;
+
+    if (animation.isBound ())
+    {
+        // components can only be checked from the message thread.
+        jassert (!isRealtime ());
+
+        const auto* component { animation.getBoundComponent () };
+        if (component == nullptr)
+        {
+            // nothing left to animate.
+            animation.cancel (false);
+            recordCompletion (animation, true);
+            return true;
+        }
+
+        if (!isComponentOnScreen (*component))
+        {
+            // Start the clock now so we catch up correctly later; if we're
+            // offscreen when we should finish, go ahead and finish anyway.
+            if (!animation.hasStarted ())
+                animation.setStartTime (timeInMs);
+
+            const auto duration { animation.getDuration () };
+            if (duration < 0 || timeInMs < animation.getFinishTime ())
+                return false;
+        }
+    }
+
+    const auto priority { animation.getPriority () };
+    const auto degraded { (degradeLevel >= 1 && priority == AnimationType::Priority::low) ||
+                          (degradeLevel >= 2 && priority == AnimationType::Priority::normal) };
+
+    if (degraded)
+    {
+        if (degradation == Degradation::snapToEnd && priority == AnimationType::Priority::low)
+        {
+            animation.cancel (true);
+            recordCompletion (animation, true);
+            ++budgetStats.animationsSnapped;
+            return true;
+        }
+
+        // a skipped animation catches up on its next update.
+        if (reducedFrame)
+        {
+            ++budgetStats.updatesSkipped;
+            return false;
+        }
+    }
+
+    auto status { animation.gotoTime (timeInMs) };
+    // if the animation just finished, let it send its completion now instead
+    // of on the next update (when it might already have been cleaned up.)
+    if (status != AnimationType::Status::finished && animation.isFinished ())
+        status = animation.gotoTime (timeInMs);
+
+    if (status != AnimationType::Status::finished)
+        return false;
+
+    recordCompletion (animation, false);
+    return true;
+}
+
+void Animator::recordCompletion (const AnimationType& animation, bool wasCanceled)
+{
+    if (completionSink != nullptr && !isRealtime () && !timeline)
+        completions.push_back ({ animation.getId (), wasCanceled });
+}
+
+void Animator::sendCompletions ()
+{
+    if (completions.empty ())
+        return;
+
+    // the sink may add or cancel animations, so hand it a batch of its own.
+    std::vector<Completion> batch;
+    batch.swap (completions);
+    completionSink (batch);
+
+    // reuse the storage for the next frame.
+    if (completions.empty ())
+    {
+        batch.clear ();
+        completions.swap (batch);
+    }
+}
+
+void Animator::onFrameBegin (FrameFn frameBegin)
+{
+    const Lock lock { *this };
+    frameBeginFn = std::move (frameBegin);
+}
+
+void Animator::onFrameEnd (FrameFn frameEnd)
+{
+    const Lock lock { *this };
+    frameEndFn = std::move (frameEnd);
+}
+
+void Animator::setCompletionSink (CompletionSink sink)
+{
+    const Lock lock { *this };
+    completionSink = std::move (sink);
+}
+
+void Animator::updateDegradeLevel (double elapsedMs)
+{
+    if (elapsedMs > frameBudget)
+    {
+        ++budgetStats.framesOverBudget;
+        degradeLevel = std::min (2, degradeLevel + 1);
+    }
+    else if (elapsedMs < frameBudget / 2.0)
+        degradeLevel = std::max (0, degradeLevel - 1);
 }
 
 bool Animator::addAnimation (std::unique_ptr<AnimationType> animation)
@@ -99,10 +431,60 @@ bool Animator::addAnimation (std::unique_ptr<AnimationType> animation)
         return false;
     }
 
-    juce::ScopedLock lock (mutex);
-    animations.push_back (std::move (animation));
+    if (isRealtime ())
+    {
+        // We can't touch the active list from this thread; hand the animation
+        // over to the realtime thread, which will pick it up on its next update.
+        animation->setCompletionDeferred (true);
+        if (!realtimeQueues->add (animation.get ()))
+        {
+            // more animations than the capacity passed to enableRealtimeMode()
+            jassertfalse;
+            return false;
+        }
+        animation.release ();
+        if (!paused)
+            controller->start ();
+        return true;
+    }
+
+    const Lock lock { *this };
+
+    if (timeline)
+    {
+        animation->setStartTime (0);
+        animation->visitValues (
+            [this] (AnimatedValue& value)
+            {
+                if (auto* physicsValue { dynamic_cast<ToleranceValue*> (&value) })
+                    physicsValue->setCheckpointInterval (checkpointInterval);
+            });
+    }
+    else if (batchPhysics)
+    {
+        // an animation that already runs on its own clock steps itself.
+        animation->clockChanged = false;
+        animation->clockChanges = &clockChanges;
+        if (!animation->hasOwnClock ())
+        {
+            animation->visitValues (
+                [this] (AnimatedValue& value)
+                {
+                    if (auto* physicsValue { dynamic_cast<ToleranceValue*> (&value) })
+                        physicsValue->attachIntegrator (integrator);
+                });
+        }
+    }
+
+    indexTags (*animation);
+
+    // in timeline mode, everything needs to be seekable from time 0.
+    if (!timeline && animation->getDelay () > 0)
+        arriving.push_back (std::move (animation));
+    else
+        animations.push_back (std::move (animation));
 
-    if (!controller->isRunning ())
+    if (!paused && !controller->isRunning ())
     {
         controller->start ();
     }
@@ -113,21 +495,73 @@ bool Animator::addAnimation (std::unique_ptr<AnimationType> animation)
 bool Animator::cancelAnimation (int id, bool moveToEndPosition)
 {
     int cancelCount { 0 };
-    juce::ScopedLock lock (mutex);
-    for (auto& animation : animations)
-    {
-        if ((id < 0) || (animation->getId () == id))
+    const Lock lock { *this };
+    visitAnimations (
+        [&] (AnimationType& animation)
         {
-            animation->cancel (moveToEndPosition);
-            ++cancelCount;
-        }
-    }
+            if ((id < 0) || (animation.getId () == id))
+            {
+                animation.cancel (moveToEndPosition);
+                recordCompletion (animation, true);
+                ++cancelCount;
+            }
+        });
     if (cancelCount == 0)
         return false;
 
+    removeCanceled ([id] (const AnimationType& animation)
+                    { return (id < 0) || (animation.getId () == id); });
+    return true;
+}
+
+void Animator::removeCanceled (const std::function<bool (const AnimationType&)>& wasCanceled)
+{
+    const auto erase { [&] (AnimationType& animation)
+                       {
+                           if (!wasCanceled (animation))
+                               return false;
+                           unindexTags (animation);
+                           forgetClockChange (animation);
+                           return true;
+                       } };
+
+    // delayed animations that were canceled before they started won't be
+    // finished, so we need to remove them explicitly.
+    removeWaiting (erase);
+
+    if (timeline)
+    {
+        // finished animations stay on the timeline; only remove the ones we
+        // just canceled.
+        animations.erase (std::remove_if (animations.begin (), animations.end (),
+                                          [&] (const std::unique_ptr<AnimationType>& c)
+                                          { return erase (*c); }),
+                          animations.end ());
+        if (animations.empty ())
+            controller->stop ();
+        return;
+    }
+
     // remove any animations we just canceled.
     cleanup ();
-    return true;
+}
+
+void Animator::removeWaiting (const std::function<bool (AnimationType&)>& shouldRemove)
+{
+    arriving.erase (std::remove_if (arriving.begin (), arriving.end (),
+                                    [&] (const std::unique_ptr<AnimationType>& c)
+                                    { return shouldRemove (*c); }),
+                    arriving.end ());
+
+    // removing entries keeps the others in order, which may not be a heap.
+    const auto delayedEnd { std::remove_if (delayed.begin (), delayed.end (),
+                                            [&] (const Delayed& entry)
+                                            { return shouldRemove (*entry.animation); }) };
+    if (delayedEnd != delayed.end ())
+    {
+        delayed.erase (delayedEnd, delayed.end ());
+        std::make_heap (delayed.begin (), delayed.end (), std::greater<> ());
+    }
 }
 
 bool Animator::cancelAllAnimations (bool moveToEndPosition)
@@ -137,61 +571,501 @@ bool Animator::cancelAllAnimations (bool moveToEndPosition)
 
 void Animator::cleanup ()
 {
-    juce::ScopedLock lock (mutex);
-    animations.erase (
-        std::remove_if (animations.begin (), animations.end (),
-                        [&] (const std::unique_ptr<AnimationType>& c) -> bool
-                        { return c->isFinished (); }),
-        animations.end ());
+    const Lock lock { *this };
+
+    if (isRealtime ())
+    {
+        // We can't delete anything on the realtime thread. Hand finished
+        // animations to the message thread; anything that doesn't fit in the
+        // queue stays here until the next update.
+        for (auto& animation : animations)
+        {
+            if ((animation->isFinished () || animation->retired) &&
+                realtimeQueues->outgoing.push (animation.get ()))
+                animation.release ();
+        }
+        animations.erase (std::remove (animations.begin (), animations.end (), nullptr),
+                          animations.end ());
+
+        // the controller keeps running; stopping it here could race with an
+        // animation being added on another thread.
+        return;
+    }
+
+    animations.erase (std::remove_if (animations.begin (), animations.end (),
+                                      [&] (const std::unique_ptr<AnimationType>& c) -> bool
+                                      {
+                                          if (!c->isFinished () && !c->retired)
+                                              return false;
+                                          unindexTags (*c);
+                                          forgetClockChange (*c);
+                                          return true;
+                                      }),
+                      animations.end ());
 
-    if (0 == animations.size ())
+    // keep running until any completions from a cancel have been sent.
+    if (animations.empty () && arriving.empty () && delayed.empty () && completions.empty ())
         controller->stop ();
 }
 
-AnimationType* Animator::getAnimation (int id)
+void Animator::startDelayed (juce::int64 timeInMs)
+{
+    for (auto& animation : arriving)
+    {
+        if (animation->retired)
+            continue;
+
+        // count the delay from now, as the animation would if it were active.
+        animation->setStartTime (timeInMs);
+        const auto activeTime { timeInMs + animation->getDelay () };
+        delayed.push_back ({ activeTime, std::move (animation) });
+        std::push_heap (delayed.begin (), delayed.end (), std::greater<> ());
+    }
+    arriving.clear ();
+
+    while (!delayed.empty () && delayed.front ().activeTime <= timeInMs)
+    {
+        std::pop_heap (delayed.begin (), delayed.end (), std::greater<> ());
+        if (!delayed.back ().animation->retired)
+            animations.push_back (std::move (delayed.back ().animation));
+        delayed.pop_back ();
+    }
+}
+
+void Animator::enableRealtimeMode (int capacity)
+{
+    jassert (capacity > 0);
+    const juce::ScopedLock lock { mutex };
+
+    // this needs to be set up before anything is running.
+    jassert (animations.empty () && realtimeQueues == nullptr);
+
+    animations.reserve (static_cast<size_t> (capacity));
+    realtimeCapacity = animations.capacity ();
+    realtimeQueues   = std::make_unique<RealtimeQueues> (capacity);
+}
+
+void Animator::setBatchedPhysics (bool shouldBatch)
+{
+    // the integrator may need to allocate as values are added.
+    jassert (!(shouldBatch && isRealtime ()));
+
+    const Lock lock { *this };
+    batchPhysics = shouldBatch && !isRealtime ();
+}
+
+void Animator::setTimelineMode (bool shouldUseTimeline, int checkpointIntervalMs)
+{
+    // animations can't be repositioned from a realtime thread.
+    jassert (!(shouldUseTimeline && isRealtime ()));
+
+    const Lock lock { *this };
+    // this needs to be set up before anything is running.
+    jassert (animations.empty ());
+
+    timeline           = shouldUseTimeline && !isRealtime ();
+    checkpointInterval = checkpointIntervalMs;
+}
+
+void Animator::pause ()
+{
+    const Lock lock { *this };
+    if (paused)
+        return;
+
+    paused = true;
+    controller->stop ();
+}
+
+void Animator::resume ()
+{
+    const Lock lock { *this };
+    if (!paused)
+        return;
+
+    // don't count the time we were paused.
+    paused             = false;
+    lastControllerTime = -1;
+    if (!animations.empty () || !arriving.empty () || !delayed.empty () ||
+        !completions.empty ())
+        controller->start ();
+}
+
+void Animator::setTimeScale (float scale)
+{
+    jassert (scale >= 0.f);
+    const Lock lock { *this };
+    timeScale = std::max (0.f, scale);
+}
+
+void Animator::detachOwnClocks ()
+{
+    for (auto* animation : clockChanges)
+    {
+        if (animation->takeClockChange () && animation->hasOwnClock ())
+        {
+            animation->visitValues (
+                [] (AnimatedValue& value)
+                {
+                    if (auto* physicsValue { dynamic_cast<ToleranceValue*> (&value) })
+                        physicsValue->detachIntegrator ();
+                });
+        }
+    }
+    clockChanges.clear ();
+}
+
+void Animator::forgetClockChange (AnimationType& animation)
+{
+    if (animation.clockChanged)
+    {
+        clockChanges.erase (
+            std::remove (clockChanges.begin (), clockChanges.end (), &animation),
+            clockChanges.end ());
+    }
+}
+
+juce::int64 Animator::advanceAnimationClock (juce::int64 controllerTime)
+{
+    if (animationTime < 0.0)
+        animationTime = static_cast<double> (controllerTime);
+    else if (lastControllerTime >= 0)
+        animationTime += static_cast<double> (controllerTime - lastControllerTime) * timeScale;
+
+    lastControllerTime = controllerTime;
+    return static_cast<juce::int64> (animationTime);
+}
+
+juce::int64 Animator::toAnimationTime (juce::int64 controllerTime) const
+{
+    if (timeline || animationTime < 0.0)
+        return controllerTime;
+
+    if (paused || lastControllerTime < 0)
+        return static_cast<juce::int64> (animationTime);
+
+    return static_cast<juce::int64> (
+        animationTime + static_cast<double> (controllerTime - lastControllerTime) * timeScale);
+}
+
+void Animator::setFrameBudget (double budgetMs, Degradation mode, int divisor)
+{
+    jassert (divisor > 0);
+
+    const Lock lock { *this };
+    frameBudget        = budgetMs;
+    degradation        = mode;
+    reducedRateDivisor = std::max (1, divisor);
+    degradeLevel       = 0;
+}
+
+Animator::BudgetStats Animator::getBudgetStats () const
+{
+    const Lock lock { *this };
+    return budgetStats;
+}
+
+void Animator::resetBudgetStats ()
 {
-    juce::ScopedLock lock (mutex);
+    const Lock lock { *this };
+    budgetStats = {};
+}
+
+juce::int64 Animator::getTimelineDuration ()
+{
+    const Lock lock { *this };
+
+    juce::int64 longest { 0 };
     for (auto& animation : animations)
     {
-        if (id == animation->getId ())
-            return animation.get ();
+        const auto duration { animation->getDuration () };
+        if (duration < 0)
+            return -1;
+        longest = std::max (longest, duration);
+    }
+    return longest;
+}
+
+#if JUCE_DEBUG
+bool Animator::isInRealtimeUpdate ()
+{
+    return inRealtimeUpdate;
+}
+#endif
+
+void Animator::acceptIncoming ()
+{
+    while (animations.size () < realtimeCapacity)
+    {
+        auto* animation { realtimeQueues->incoming.pop () };
+        if (animation == nullptr)
+            return;
+
+        animations.emplace_back (animation);
     }
-    return nullptr;
+
+    // We're at capacity. Anything still waiting will be picked up as space frees
+    // up, but if that's the case, the capacity passed to enableRealtimeMode() is
+    // too small.
+    jassert (realtimeQueues->incoming.isEmpty ());
+}
+
+AnimationType* Animator::getAnimation (int id)
+{
+    const Lock lock { *this };
+    AnimationType* found { nullptr };
+    visitAnimations (
+        [&] (AnimationType& animation)
+        {
+            if (found == nullptr && id == animation.getId ())
+                found = &animation;
+        });
+    return found;
 }
 
 int Animator::getAnimations (int id, std::vector<AnimationType*>& foundAnimations)
 {
     int foundCount { 0 };
 
-    juce::ScopedLock lock (mutex);
-    for (auto& animation : animations)
+    const Lock lock { *this };
+    visitAnimations (
+        [&] (AnimationType& animation)
+        {
+            if (id == animation.getId ())
+            {
+                foundAnimations.push_back (&animation);
+                ++foundCount;
+            }
+        });
+    return foundCount;
+}
+
+bool Animator::updateTarget (int id, int valueIndex, float newTarget)
+{
+    const Lock lock { *this };
+
+    bool found { false };
+    visitAnimations (
+        [&] (AnimationType& animation)
+        {
+            if (id == animation.getId ())
+            {
+                found = true;
+                animation.updateTarget (static_cast<size_t> (valueIndex), newTarget);
+            }
+        });
+    return found;
+}
+
+int Animator::updateTargets (const TargetUpdate* updates, size_t count)
+{
+    if (count == 0)
+        return 0;
+
+    int updatedCount { 0 };
+    const Lock lock { *this };
+
+    sortedUpdates.clear ();
+    for (size_t i { 0 }; i < count; ++i)
+        sortedUpdates.push_back (updates + i);
+
+    const auto byId { [] (const TargetUpdate* lhs, const TargetUpdate* rhs)
+                      { return lhs->id < rhs->id; } };
+    if (!std::is_sorted (sortedUpdates.begin (), sortedUpdates.end (), byId))
+    {
+        // the pointers are in the order given, so breaking ties with them
+        // keeps changes to the same animation in order without a stable sort.
+        std::sort (sortedUpdates.begin (), sortedUpdates.end (),
+                   [] (const TargetUpdate* lhs, const TargetUpdate* rhs)
+                   { return lhs->id < rhs->id || (lhs->id == rhs->id && lhs < rhs); });
+    }
+
+    visitAnimations (
+        [&] (AnimationType& animation)
+        {
+            const TargetUpdate key { animation.getId (), 0, 0.f };
+            const auto range { std::equal_range (sortedUpdates.begin (), sortedUpdates.end (),
+                                                 &key, byId) };
+            for (auto it { range.first }; it != range.second; ++it)
+            {
+                const auto& update { **it };
+                if (animation.updateTarget (static_cast<size_t> (update.valueIndex),
+                                            update.target))
+                    ++updatedCount;
+            }
+        });
+    return updatedCount;
+}
+
+int Animator::updateTargets (int id, const float* targets, size_t count)
+{
+    int updatedCount { 0 };
+    const Lock lock { *this };
+
+    visitAnimations (
+        [&] (AnimationType& animation)
+        {
+            if (id != animation.getId ())
+                return;
+
+            for (size_t i { 0 }; i < count; ++i)
+            {
+                if (animation.updateTarget (i, targets[i]))
+                    ++updatedCount;
+            }
+        });
+    return updatedCount;
+}
+
+bool Animator::sample (int id, juce::int64 timeInMs, float* values, size_t valueCount)
+{
+    const Lock lock { *this };
+    if (auto* animation { getAnimation (id) }; animation != nullptr)
+        return animation->sample (animation->toLocalTime (toAnimationTime (timeInMs)),
+                                  values, valueCount);
+
+    return false;
+}
+
+void Animator::indexTags (AnimationType& animation)
+{
+    const auto tags { animation.getTags () };
+    animation.tagSlots.clear ();
+    for (size_t bit { 0 }; bit < tagIndex.size (); ++bit)
     {
-        if (id == animation->getId ())
+        if ((tags & (1u << bit)) != 0)
         {
-            foundAnimations.push_back (animation.get ());
-            ++foundCount;
+            animation.tagSlots.push_back (tagIndex[bit].size ());
+            tagIndex[bit].push_back (&animation);
         }
     }
-    return foundCount;
+    animation.tagsIndexed = true;
 }
 
-bool Animator::updateTarget (int id, int valueIndex, float newTarget)
+void Animator::unindexTags (AnimationType& animation)
 {
-    juce::ScopedLock lock (mutex);
+    if (!animation.tagsIndexed)
+        return;
+
+    const auto tags { animation.getTags () };
+    size_t slot { 0 };
+    for (size_t bit { 0 }; bit < tagIndex.size (); ++bit)
+    {
+        if ((tags & (1u << bit)) == 0)
+            continue;
+
+        // order doesn't matter, so move the last entry into our place and
+        // tell it where it went.
+        auto& tagged { tagIndex[bit] };
+        const auto position { animation.tagSlots[slot++] };
+        auto* moved { tagged.back () };
+        tagged[position] = moved;
+        tagged.pop_back ();
+
+        if (moved != &animation)
+        {
+            const auto lowerTags { moved->getTags () & ((1u << bit) - 1u) };
+            moved->tagSlots[static_cast<size_t> (juce::countNumberOfBits (lowerTags))] =
+                position;
+        }
+    }
 
-    std::vector<AnimationType*> foundAnimations;
+    animation.tagSlots.clear ();
+    animation.tagsIndexed = false;
+}
+
+int Animator::getTaggedAnimations (juce::uint32 tags, std::vector<AnimationType*>& found)
+{
+    // tags aren't indexed in realtime mode.
+    jassert (!isRealtime ());
 
-    if (getAnimations (id, foundAnimations) > 0)
+    const Lock lock { *this };
+    const auto firstNew { found.size () };
+    int tagCount { 0 };
+    for (size_t bit { 0 }; bit < tagIndex.size (); ++bit)
     {
-        for (auto* animation : foundAnimations)
+        if ((tags & (1u << bit)) != 0)
         {
-            auto* value { animation->getValue (valueIndex) };
-            if (value)
-                value->updateTarget (newTarget);
+            found.insert (found.end (), tagIndex[bit].begin (), tagIndex[bit].end ());
+            ++tagCount;
         }
-        return true;
     }
-    return false;
+
+    // an animation with more than one of these tags is only listed once.
+    if (tagCount > 1)
+    {
+        const auto start { found.begin () + static_cast<std::ptrdiff_t> (firstNew) };
+        std::sort (start, found.end ());
+        found.erase (std::unique (start, found.end ()), found.end ());
+    }
+    return static_cast<int> (found.size () - firstNew);
+}
+
+int Animator::cancelTagged (juce::uint32 tags, bool moveToEndPosition)
+{
+    const Lock lock { *this };
+    std::vector<AnimationType*> tagged;
+    if (getTaggedAnimations (tags, tagged) == 0)
+        return 0;
+
+    // They'll be deleted on the next update; finding them in our lists now
+    // would take time proportional to the number of animations we have.
+    for (auto* animation : tagged)
+    {
+        animation->cancel (moveToEndPosition);
+        recordCompletion (*animation, true);
+        unindexTags (*animation);
+        animation->retired = true;
+    }
+
+    // ...but those that are still waiting to start would otherwise wait until
+    // their pre-delay is over, keeping us running.
+    if (!arriving.empty () || !delayed.empty ())
+    {
+        removeWaiting (
+            [this] (AnimationType& animation)
+            {
+                if (!animation.retired)
+                    return false;
+                forgetClockChange (animation);
+                return true;
+            });
+    }
+    return static_cast<int> (tagged.size ());
+}
+
+int Animator::pauseTagged (juce::uint32 tags, bool shouldPause)
+{
+    const Lock lock { *this };
+    std::vector<AnimationType*> tagged;
+    getTaggedAnimations (tags, tagged);
+    for (auto* animation : tagged)
+        animation->setPaused (shouldPause);
+    return static_cast<int> (tagged.size ());
+}
+
+int Animator::setTimeScaleTagged (juce::uint32 tags, float scale)
+{
+    const Lock lock { *this };
+    std::vector<AnimationType*> tagged;
+    getTaggedAnimations (tags, tagged);
+    for (auto* animation : tagged)
+        animation->setTimeScale (scale);
+    return static_cast<int> (tagged.size ());
+}
+
+int Animator::updateTargetTagged (juce::uint32 tags, int valueIndex, float newTarget)
+{
+    int updatedCount { 0 };
+    const Lock lock { *this };
+    std::vector<AnimationType*> tagged;
+    getTaggedAnimations (tags, tagged);
+    for (auto* animation : tagged)
+    {
+        if (animation->updateTarget (static_cast<size_t> (valueIndex), newTarget))
+            ++updatedCount;
+    }
+    return updatedCount;
 }
 
 #ifdef qRunUnitTests
@@ -99,6 +99,12 @@ public:
 
     /**
      * Add a new animation to our list, which will start it going!
+     *
+     * An animation with a pre-delay (see `AnimationType::setDelay()`) is held
+     * in a queue ordered by start time instead, and only joins the active list
+     * once its delay expires, so large numbers of staggered animations waiting
+     * to start cost nothing on each frame. Its delay is counted from the first
+     * update after it's added, as it would be if it were active.
      * @param  animation The animation sequence to play.
      * @return           true if added okay.
      */
@@ -154,6 +160,360 @@ public:
      */
     bool updateTarget (int id, int valIndex, float newTarget);
 
+    /**
+     * @brief One target change for `updateTargets()`
+     */
+    struct TargetUpdate
+    {
+        /// @brief ID of the animation(s) to change.
+        int id;
+        /// @brief index of the value within the animation.
+        int valueIndex;
+        float target;
+    };
+
+    /**
+     * @brief Apply many target changes at once, taking our lock once and making a
+     * single pass through the active animations, instead of a lock and a full
+     * scan for each call to `updateTarget()`. The changes are sorted by ID (in
+     * a buffer that we keep between calls) so that each animation only looks
+     * at its own; changes to the same value are applied in the order given.
+     * Changes that are already sorted by ID aren't sorted again.
+     *
+     * @param updates array of changes to apply.
+     * @param count number of changes.
+     * @return int number of values that accepted their new target.
+     */
+    int updateTargets (const TargetUpdate* updates, size_t count);
+
+    /**
+     * @brief Convenience version of `updateTargets()` for a vector of changes.
+     */
+    int updateTargets (const std::vector<TargetUpdate>& updates)
+    {
+        return updateTargets (updates.data (), updates.size ());
+    }
+
+    /**
+     * @brief Set new targets for all of the values of the animation(s) with
+     * an ID at once (e.g. all four values of a rectangle).
+     *
+     * @param id
+     * @param targets new target for each value, in order.
+     * @return int number of values that accepted their new target.
+     */
+    template <std::size_t ValueCount>
+    int updateTargets (int id, const std::array<float, ValueCount>& targets)
+    {
+        return updateTargets (id, targets.data (), ValueCount);
+    }
+
+    /**
+     * @brief Set new targets for the first `count` values of the animation(s)
+     * with an ID.
+     */
+    int updateTargets (int id, const float* targets, size_t count);
+
+    /**
+     * @brief An animation that completed or was canceled.
+     */
+    struct Completion
+    {
+        int id;
+        bool wasCanceled;
+    };
+
+    /**
+     * @brief Called with all of the animations that completed during an update,
+     * including any canceled by `cancelAnimation()` etc. since the last one.
+     */
+    using CompletionSink = std::function<void (const std::vector<Completion>&)>;
+
+    /**
+     * @brief Receive all of the completions from each frame in a single call
+     * once all of the animations have been updated, e.g. to do any follow-up
+     * layout just once when many staggered items finish together; it's called
+     * at most once per frame. Individual completion callbacks are still called
+     * as usual. Completions of animations inside a `Chain`, `Group` etc. aren't
+     * included, only the container.
+     *
+     * Not used in realtime or timeline mode.
+     *
+     * @param sink
+     */
+    void setCompletionSink (CompletionSink sink);
+
+    /**
+     * @brief Called at the start and end of each frame, with the time that's
+     * being passed to the animations.
+     */
+    using FrameFn = std::function<void (juce::int64)>;
+
+    /**
+     * @brief Set a function to be called at the start of each frame, before
+     * any animations are updated. Pass nullptr to remove it.
+     *
+     * @param frameBegin
+     */
+    void onFrameBegin (FrameFn frameBegin);
+
+    /**
+     * @brief Set a function to be called at the end of each frame, once all of
+     * the animations have been updated (and any completions sent), e.g. to
+     * repaint everything that changed at once (see `RepaintCoalescer`). Pass
+     * nullptr to remove it.
+     *
+     * In realtime mode, both frame functions are called on the realtime thread.
+     *
+     * @param frameEnd
+     */
+    void onFrameEnd (FrameFn frameEnd);
+
+    /**
+     * @brief Find all the animations that have any of a set of tags (see
+     * `AnimationType::setTags()`). We keep an index of the animations with
+     * each tag, so the operations on tagged animations take time proportional
+     * to the number of animations that are tagged, not the number running.
+     *
+     * Tags aren't available in realtime mode.
+     *
+     * @param tags      bit mask of the tags to look for.
+     * @param animations vector to fill with non-owning pointers.
+     * @return int number of animations found.
+     */
+    int getTaggedAnimations (juce::uint32 tags, std::vector<AnimationType*>& animations);
+
+    /**
+     * @brief Cancel every animation with any of these tags, e.g. all of the
+     * animations owned by a component that's about to be deleted. They're
+     * removed from the index now, and deleted on our next update.
+     *
+     * @param tags bit mask of tags.
+     * @param moveToEndPosition true to force all values to their end positions first.
+     * @return int number of animations canceled.
+     */
+    int cancelTagged (juce::uint32 tags, bool moveToEndPosition);
+
+    /**
+     * @brief Pause or resume every animation with any of these tags.
+     *
+     * @return int number of animations changed.
+     */
+    int pauseTagged (juce::uint32 tags, bool shouldPause);
+
+    /**
+     * @brief Set the time scale of every animation with any of these tags.
+     *
+     * @return int number of animations changed.
+     */
+    int setTimeScaleTagged (juce::uint32 tags, float scale);
+
+    /**
+     * @brief Set a new target for one value of every animation with any of these tags.
+     *
+     * @return int number of values that accepted their new target.
+     */
+    int updateTargetTagged (juce::uint32 tags, int valueIndex, float newTarget);
+
+    /**
+     * @brief Pull the values of a running animation at a point in time, instead of
+     * (or in addition to) having them pushed to its `updateFn`. This lets a
+     * component evaluate exactly what it needs from inside its `paint()` method;
+     * an animation with no `updateFn` whose values can all be sampled skips
+     * evaluation entirely on each frame.
+     *
+     * @param id         ID of the animation. If more than one animation uses this ID,
+     *                   the first one found is sampled.
+     * @param timeInMs   Time to sample at, on the same clock the controller uses
+     *                   (`Controller::getCurrentTime()` for the realtime controllers);
+     *                   it's converted to our own clock (see `pause()` and
+     *                   `setTimeScale()`)
+     * @param values     array to fill, at least `valueCount` long.
+     * @param valueCount number of values to retrieve.
+     * @return true if the animation exists and supports sampling.
+     */
+    bool sample (int id, juce::int64 timeInMs, float* values, size_t valueCount);
+
+    /**
+     * @brief Typed convenience version of `sample()`
+     */
+    template <std::size_t ValueCount>
+    bool sample (int id, juce::int64 timeInMs, std::array<float, ValueCount>& values)
+    {
+        return sample (id, timeInMs, values.data (), ValueCount);
+    }
+
+    /**
+     * @brief Configure this animator so it can be safely updated from a realtime
+     * thread, e.g. by calling `AsyncController::gotoTime()` from an audio callback.
+     * In realtime mode:
+     *
+     * - space for `capacity` animations is allocated up front and never grows;
+     *   `addAnimation()` fails if we're full.
+     * - `gotoTime()` doesn't lock or allocate. Animations added from another
+     *   thread are handed to the realtime thread through a lock-free FIFO.
+     * - finished animations are handed back to the message thread through a
+     *   second FIFO; their completion callbacks are executed (and the
+     *   animations deleted) there, by a timer that only runs while there are
+     *   animations that haven't been deleted.
+     *
+     * Update callbacks run on the realtime thread and must not allocate or lock.
+     * `addAnimation()` may be called from a single non-realtime thread; all other
+     * methods must be called from the thread that's driving the controller.
+     *
+     * Call this from the message thread, before adding any animations.
+     *
+     * @param capacity maximum number of animations that can be active at once.
+     */
+    void enableRealtimeMode (int capacity);
+
+    /**
+     * @return true if this animator is running in realtime mode.
+     */
+    bool isRealtime () const { return realtimeQueues != nullptr; }
+
+#if JUCE_DEBUG
+    /**
+     * @brief Test whether the calling thread is currently inside a realtime
+     * update. Debug builds can check this from an allocation hook (e.g. a
+     * replacement `operator new`) to catch update callbacks that allocate.
+     */
+    static bool isInRealtimeUpdate ();
+#endif
+
+    /**
+     * @brief Step the physics-style values (`Spring`, `EaseIn`, `EaseOut`,
+     * `SmoothedValue`) of all subsequently added animations together in one
+     * shared fixed-timestep integrator, instead of each value running its own
+     * stepping loop. The curves behave exactly as they do when stepped
+     * individually, but the cost of animating many of them is much lower.
+     *
+     * Not available in realtime mode.
+     *
+     * @param shouldBatch
+     */
+    void setBatchedPhysics (bool shouldBatch);
+
+    /**
+     * @brief Put this animator into timeline mode, for scrubbing back and forth
+     * through a set of animations (e.g. an editor with a draggable playhead),
+     * driven by an `AsyncController`. In timeline mode:
+     *
+     * - every animation starts at time 0 (plus its pre-delay).
+     * - `gotoTime()` may move backward as well as forward.
+     * - animations stay in the animator after they finish, so we can go back to
+     *   them; they're only removed when canceled.
+     * - time-based values (`Linear`, `Parametric`, etc.) are evaluated directly
+     *   at any time. Physics-style values save a checkpoint of their state every
+     *   `checkpointIntervalMs` as they run, so going back restores the nearest
+     *   checkpoint instead of replaying from the start.
+     *
+     * Not available in realtime mode, and physics values aren't batched.
+     * Call this before adding any animations.
+     *
+     * @param shouldUseTimeline
+     * @param checkpointIntervalMs
+     */
+    void setTimelineMode (bool shouldUseTimeline, int checkpointIntervalMs = 100);
+
+    /**
+     * @return true if this animator is in timeline mode.
+     */
+    bool isTimeline () const { return timeline; }
+
+    /**
+     * @return the time at which all of our animations will have finished, or -1
+     * if any of them has a duration that can't be known in advance.
+     */
+    juce::int64 getTimelineDuration ();
+
+    /**
+     * @brief Freeze all of our animations where they are. The controller is
+     * stopped, so nothing runs (and no CPU is used) until `resume()` is called.
+     *
+     * Our animations run on a clock of their own that only advances while
+     * we're running, so they don't jump ahead by the time we were paused.
+     */
+    void pause ();
+
+    /**
+     * @brief Continue from where we were paused.
+     */
+    void resume ();
+
+    /**
+     * @return true if we're paused.
+     */
+    bool isPaused () const { return paused; }
+
+    /**
+     * @brief Run all of our animations faster or slower than real time, e.g.
+     * 0.1 to slow everything down while debugging, or 0 to freeze them without
+     * stopping the controller. Changes take effect smoothly from the current
+     * time. Not used in timeline mode.
+     *
+     * @param scale multiplier for the rate of our clock, >= 0.
+     */
+    void setTimeScale (float scale);
+
+    /**
+     * @return the current time scale.
+     */
+    float getTimeScale () const { return timeScale; }
+
+    /**
+     * @brief What to do with lower priority animations when we're over our
+     * frame budget.
+     */
+    enum class Degradation
+    {
+        reduceRate, ///< Only update them on every Nth frame.
+        snapToEnd   ///< Cancel them, moving to their end values.
+    };
+
+    /**
+     * @brief Set a limit on how long each update may take. If an update runs
+     * over the budget, on following updates we first degrade `low` priority
+     * animations; if we're still over budget, `normal` priority animations are
+     * also updated at a reduced rate (they're never snapped to their end). `high`
+     * priority animations always run at the full frame rate. Once updates are
+     * comfortably within the budget again (under half of it), we step back up.
+     *
+     * Snapped animations are canceled, so their completion callbacks report
+     * `wasCanceled == true`. Not used in timeline mode.
+     *
+     * @param budgetMs  maximum time to spend per update in ms; <= 0 to disable.
+     * @param mode      how to degrade `low` priority animations.
+     * @param reducedRateDivisor a degraded animation is updated once every this many frames.
+     */
+    void setFrameBudget (double budgetMs, Degradation mode = Degradation::reduceRate,
+                         int reducedRateDivisor = 2);
+
+    /**
+     * @brief Counters to see how often we've had to degrade animations.
+     */
+    struct BudgetStats
+    {
+        /// @brief number of updates that took longer than the budget.
+        int framesOverBudget { 0 };
+        /// @brief number of updates where some animations were degraded.
+        int framesDegraded { 0 };
+        /// @brief number of animation updates skipped to reduce their rate.
+        int updatesSkipped { 0 };
+        /// @brief number of animations snapped to their end values.
+        int animationsSnapped { 0 };
+    };
+
+    /**
+     * @return our counters since they were last reset.
+     */
+    BudgetStats getBudgetStats () const;
+
+    /**
+     * @brief Set all of the budget counters back to zero.
+     */
+    void resetBudgetStats ();
+
 private:
     /**
      * Remove any animations that are complete or canceled from the list.
@@ -161,16 +521,239 @@ private:
      */
     void cleanup ();
 
+    /**
+     * @brief Remove animations that were just canceled (the delayed ones
+     * haven't finished, and on a timeline nothing is removed when it finishes.)
+     *
+     * @param wasCanceled returns true for each animation that should be removed.
+     */
+    void removeCanceled (const std::function<bool (const AnimationType&)>& wasCanceled);
+
+    /**
+     * @brief Remove animations that are still waiting out their pre-delay.
+     *
+     * @param shouldRemove returns true for each animation that should be
+     * removed; it's called before the animation is deleted.
+     */
+    void removeWaiting (const std::function<bool (AnimationType&)>& shouldRemove);
+
+    /**
+     * @brief Add an animation to the index for each of its tags.
+     */
+    void indexTags (AnimationType& animation);
+
+    /**
+     * @brief Remove an animation from the tag index before it's deleted. Each
+     * animation knows its position in each of its tags' lists, so this swaps
+     * the last entry of each list into its place.
+     */
+    void unindexTags (AnimationType& animation);
+
+    /**
+     * @brief The integrator steps all of its values by the same amount, so
+     * take back the values of any animations that have been paused or given a
+     * time scale since the last frame; they'll step themselves on their own
+     * clocks from then on.
+     */
+    void detachOwnClocks ();
+
+    /**
+     * @brief Drop an animation that's about to be deleted from the list of
+     * those whose clocks have changed.
+     */
+    void forgetClockChange (AnimationType& animation);
+
+    /**
+     * @brief Move our own clock forward by the time since the controller's
+     * last update (scaled by our time scale).
+     *
+     * @param controllerTime time from the controller.
+     * @return the time to pass to our animations.
+     */
+    juce::int64 advanceAnimationClock (juce::int64 controllerTime);
+
+    /**
+     * @brief Convert a time from the controller's clock to ours without
+     * advancing it.
+     */
+    juce::int64 toAnimationTime (juce::int64 controllerTime) const;
+
+    /**
+     * @brief Give any delayed animations that were added since the last update a
+     * start time, and move any whose delay has expired into the active list.
+     *
+     * @param timeInMs
+     */
+    void startDelayed (juce::int64 timeInMs);
+
+    /**
+     * @brief Update a single animation, unless its priority means that it should
+     * be degraded at the current level.
+     *
+     * @return true if the animation finished (or was snapped to its end)
+     */
+    bool updateAnimation (AnimationType& animation, juce::int64 timeInMs, bool reducedFrame);
+
+    /**
+     * @brief If we have a completion sink, remember that an animation has
+     * completed, to send it with the others at the end of the update.
+     */
+    void recordCompletion (const AnimationType& animation, bool wasCanceled);
+
+    /**
+     * @brief Send any completions we've recorded to the completion sink.
+     */
+    void sendCompletions ();
+
+    /**
+     * @brief After each update, see if we need to degrade more or fewer
+     * animations on the next one.
+     *
+     * @param elapsedMs how long the update took.
+     */
+    void updateDegradeLevel (double elapsedMs);
+
+    /**
+     * @brief Call a function for each of our animations, active or delayed,
+     * skipping any that were canceled by tag and are waiting to be removed.
+     */
+    template <typename Fn> void visitAnimations (Fn&& fn)
+    {
+        for (auto& animation : animations)
+        {
+            if (!animation->retired)
+                fn (*animation);
+        }
+        for (auto& animation : arriving)
+        {
+            if (!animation->retired)
+                fn (*animation);
+        }
+        for (auto& entry : delayed)
+        {
+            if (!entry.animation->retired)
+                fn (*entry.animation);
+        }
+    }
+
+    /**
+     * @brief In realtime mode, move any animations that were added from
+     * another thread into our active list.
+     */
+    void acceptIncoming ();
+
+    /**
+     * @brief Holds our mutex for its lifetime, except in realtime mode,
+     * where we never lock.
+     */
+    class Lock
+    {
+    public:
+        explicit Lock (const Animator& animator)
+        : mutex { animator.isRealtime () ? nullptr : &animator.mutex }
+        {
+            if (mutex != nullptr)
+                mutex->enter ();
+        }
+
+        ~Lock ()
+        {
+            if (mutex != nullptr)
+                mutex->exit ();
+        }
+
+    private:
+        const juce::CriticalSection* mutex;
+    };
+
+    /// @brief FIFOs used to pass animations across threads in realtime mode.
+    class RealtimeQueues;
+
 private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Animator)
 
     std::unique_ptr<Controller> controller;
 
+    /// @brief steps batched physics values; must outlive the animations.
+    FixedStepIntegrator integrator;
+    /// @brief attach the values of new animations to the integrator?
+    bool batchPhysics { false };
+    /// @brief time the integrator was last advanced to.
+    juce::int64 integratorTime { -1 };
+    /// @brief batched animations that were paused or re-scaled since the last frame.
+    std::vector<AnimationType*> clockChanges;
+
+    /// @brief re-used by `updateTargets()` to sort the changes by ID.
+    std::vector<const TargetUpdate*> sortedUpdates;
+
+    /// @brief are we in timeline mode?
+    bool timeline { false };
+    /// @brief checkpoint spacing for physics values in timeline mode.
+    int checkpointInterval { 100 };
+
     std::vector<std::unique_ptr<AnimationType>> animations;
 
+    /// @brief An animation waiting for its pre-delay to expire.
+    struct Delayed
+    {
+        /// @brief time that the pre-delay expires.
+        juce::int64 activeTime;
+        std::unique_ptr<AnimationType> animation;
+
+        /// @brief ordering for a min-heap with `std::push_heap()` etc.
+        bool operator> (const Delayed& other) const { return activeTime > other.activeTime; }
+    };
+
+    /// @brief delayed animations added since our last update, not yet scheduled.
+    std::vector<std::unique_ptr<AnimationType>> arriving;
+    /// @brief min-heap of scheduled delayed animations, earliest first.
+    std::vector<Delayed> delayed;
+
+    /// @brief called before each update.
+    FrameFn frameBeginFn;
+    /// @brief called after each update.
+    FrameFn frameEndFn;
+
+    /// @brief receives all of the completions from each update.
+    CompletionSink completionSink;
+    /// @brief completions during the current update.
+    std::vector<Completion> completions;
+
+    /// @brief the animations with each tag bit.
+    std::array<std::vector<AnimationType*>, 32> tagIndex;
+
+    /// @brief max time per update in ms, or <= 0 if unlimited.
+    double frameBudget { 0.0 };
+    /// @brief how to degrade low priority animations.
+    Degradation degradation { Degradation::reduceRate };
+    /// @brief degraded animations are updated once every this many frames.
+    int reducedRateDivisor { 2 };
+    /// @brief 0 = no degradation, 1 = low priority, 2 = low & normal priority.
+    int degradeLevel { 0 };
+    /// @brief counts updates, to pick the frames that degraded animations run on.
+    int frameCount { 0 };
+
+    BudgetStats budgetStats;
+
+    /// @brief are we paused?
+    bool paused { false };
+    /// @brief rate of our clock relative to the controller's.
+    float timeScale { 1.f };
+    /// @brief the time on our own clock, or < 0 before our first update.
+    double animationTime { -1.0 };
+    /// @brief the controller's time at our last update, or < 0 if we've just
+    /// been resumed.
+    juce::int64 lastControllerTime { -1 };
+
     /// protect code that might contain data races if updates come
     /// from a different thread.
     juce::CriticalSection mutex;
+
+    /// @brief only created in realtime mode.
+    std::unique_ptr<RealtimeQueues> realtimeQueues;
+
+    /// @brief number of animations we've preallocated space for in realtime mode.
+    size_t realtimeCapacity { 0 };
 };
 
 } // namespace friz
@@ -59,16 +59,42 @@ public:
 
     AnimationType::Status gotoTime (juce::int64 timeInMs) override
     {
-        auto effect = getEffect (currentEffect);
-        if (effect)
+        if (startTime < 0)
+            setStartTime (timeInMs);
+
+        // still waiting for our pre-delay to expire?
+        if (timeInMs < startTime + preDelay)
+            return AnimationType::Status::processing;
+
+        // we may pass through more than one effect in a single update.
+        while (juce::isPositiveAndBelow (currentEffect, sequence.size ()))
         {
-            if (AnimationType::Status::finished == effect->gotoTime (timeInMs))
-                ++currentEffect;
+            auto effect = getEffect (currentEffect);
+            if (!effectStarted)
+            {
+                // each effect starts exactly when the previous one finished,
+                // even if that was partway through a frame.
+                effect->setStartTime ((currentEffect == 0) ? startTime + preDelay
+                                                           : handoffTime);
+                effectStarted = true;
+            }
+
+            auto status { effect->gotoTime (timeInMs) };
+            // if the effect just finished, let it send its completion now instead
+            // of on the next update.
+            if (status != AnimationType::Status::finished && effect->isFinished ())
+                status = effect->gotoTime (timeInMs);
 
-            return isFinished () ? AnimationType::Status::finished
-                                 : AnimationType::Status::processing;
+            if (status != AnimationType::Status::finished)
+                break;
+
+            handoffTime   = effect->getFinishTime ();
+            effectStarted = false;
+            ++currentEffect;
         }
-        return AnimationType::Status::finished;
+
+        return isFinished () ? AnimationType::Status::finished
+                             : AnimationType::Status::processing;
     }
 
     void cancel (bool moveToEndPosition) override
@@ -82,11 +108,101 @@ public:
         }
     }
 
+    /**
+     * @brief Each of our effects starts when the previous one ends, so to go to
+     * a point in time we find the effect that's running at that time and seek it.
+     * Any effects that we pass over on the way are moved to their end (moving
+     * forward) or start (moving backward) so that their listeners stay in sync.
+     * All of our effects except the last must have a known duration, which is
+     * read when they're added.
+     */
+    AnimationType::Status seek (juce::int64 timeInMs) override
+    {
+        const auto count { static_cast<int> (sequence.size ()) };
+        if (count == 0)
+            return AnimationType::Status::finished;
+
+        if (startTime < 0)
+            setStartTime (timeInMs);
+
+        // our effects are laid out end to end; find the one that's active at
+        // this time.
+        const auto previousEffect { std::min (currentEffect, count - 1) };
+        const auto firstStart { startTime + preDelay };
+        int target { -1 };
+        for (int i { 0 }; i < count; ++i)
+        {
+            sequence[i]->setStartTime (firstStart + effectOffsets[i]);
+
+            if (effectOffsets[i + 1] < 0)
+            {
+                // we can't know where anything after this effect begins.
+                jassert (i == count - 1);
+                target = (target < 0) ? i : target;
+                break;
+            }
+
+            if (target < 0 && timeInMs < firstStart + effectOffsets[i + 1])
+                target = i;
+        }
+        target = (target < 0) ? count - 1 : target;
+
+        for (int i { previousEffect }; i < target; ++i)
+            sequence[i]->seek (firstStart + effectOffsets[i + 1]);
+        for (int i { previousEffect }; i > target; --i)
+            sequence[i]->seek (firstStart + effectOffsets[i]);
+
+        currentEffect = target;
+        effectStarted = true;
+        if (AnimationType::Status::finished == sequence[target]->seek (timeInMs))
+            currentEffect = count;
+
+        return isFinished () ? AnimationType::Status::finished
+                             : AnimationType::Status::processing;
+    }
+
+    juce::int64 getDuration () const override
+    {
+        juce::int64 total { preDelay };
+        for (const auto& effect : sequence)
+        {
+            const auto duration { effect->getDuration () };
+            if (duration < 0)
+                return -1;
+            total += duration;
+        }
+        return total;
+    }
+
     void addAnimation (std::unique_ptr<AnimationType> effect)
     {
+        effect->setCompletionDeferred (isCompletionDeferred ());
+
+        // where the next effect will start, for seeking.
+        const auto duration { effect->getDuration () };
+        const auto end { effectOffsets.back () };
+        effectOffsets.push_back ((end < 0 || duration < 0) ? -1 : end + duration);
+
         sequence.push_back (std::move (effect));
     }
 
+    /**
+     * @brief Our effects' completions are deferred along with our own.
+     */
+    void setCompletionDeferred (bool shouldDefer) override
+    {
+        AnimationType::setCompletionDeferred (shouldDefer);
+        for (auto& effect : sequence)
+            effect->setCompletionDeferred (shouldDefer);
+    }
+
+    void sendDeferredCompletion () override
+    {
+        for (auto& effect : sequence)
+            effect->sendDeferredCompletion ();
+        AnimationType::sendDeferredCompletion ();
+    }
+
     AnimatedValue* getValue (size_t index) override
     {
         if (auto effect = getEffect (currentEffect); effect != nullptr)
@@ -94,6 +210,22 @@ public:
         return nullptr;
     }
 
+    bool updateTarget (size_t index, float newTarget) override
+    {
+        if (auto effect = getEffect (currentEffect); effect != nullptr)
+            return effect->updateTarget (index, newTarget);
+        return false;
+    }
+
+    void visitValues (const std::function<void (AnimatedValue&)>& visitor) override
+    {
+        for (auto& effect : sequence)
+        {
+            if (effect != nullptr)
+                effect->visitValues (visitor);
+        }
+    }
+
 private:
     /**
      * Get a pointer to one of our effects by its index.
@@ -116,6 +248,16 @@ protected:
     /// @brief index (into the sequence vector) of the effect that we are currently
     /// processing.
     int currentEffect { 0 };
+
+    /// @brief has the current effect's start time been set?
+    bool effectStarted { false };
+
+    /// @brief time that the previous effect finished, and the next one starts.
+    juce::int64 handoffTime { -1 };
+
+    /// @brief start time of each effect relative to our first one, followed by
+    /// the end of the last effect; -1 after an effect without a known duration.
+    std::vector<juce::int64> effectOffsets { 0 };
 };
 
 } // namespace friz
\ No newline at end of file
@@ -68,6 +68,22 @@ void FrameRateCalculator::clear ()
     updateCount.store (0);
 }
 
+juce::int64 PresentationClock::update (juce::int64 now, float refreshRate)
+{
+    auto presentationTime { now };
+    if (predict)
+    {
+        presentationTime += latencyOffset;
+        if (refreshRate > 0.f)
+            presentationTime += static_cast<juce::int64> (1000.f / refreshRate + 0.5f);
+    }
+
+    // the measured refresh interval wobbles a little from frame to frame; never
+    // let that make time run backwards.
+    frameTime = std::max (presentationTime, frameTime);
+    return frameTime;
+}
+
 void TimeController::timerCallback ()
 {
     animator->gotoTime (getCurrentTime ());
@@ -80,15 +96,17 @@ void DisplaySyncController::start ()
     if (sync.isEmpty () && animator != nullptr)
     {
         frameRate.clear ();
+        presentation.reset ();
         sync = { syncSource, [this]
                  {
                      const auto now { getCurrentTime () };
-                     animator->gotoTime (now);
                      frameRate.update (now);
+                     animator->gotoTime (presentation.update (now, frameRate.get ()));
                  } };
         running = true;
     }
 }
+
 #endif
 
 bool AsyncController::gotoTime (juce::int64 timeInMs)
@@ -96,16 +114,23 @@ bool AsyncController::gotoTime (juce::int64 timeInMs)
     if (!isRunning ())
         return false;
 
-    if (timeInMs <= lastTime)
+    const bool movingForward { timeInMs > lastTime };
+    if (!movingForward && !animator->isTimeline ())
     {
         // time can only go forward!
         jassertfalse;
         return false;
     }
     animator->gotoTime (timeInMs);
-    frameRate.update (timeInMs);
+    // scrubbing backward doesn't tell us anything about the frame rate.
+    if (movingForward)
+        frameRate.update (timeInMs);
     lastTime = timeInMs;
     return true;
 }
 
+#ifdef qRunUnitTests
+#include "test/test_Controller.cpp"
+#endif
+
 } // namespace friz
@@ -74,6 +74,63 @@ private:
     int index { 0 };
 };
 
+/**
+ * @class PresentationClock
+ * @brief Work out the time to evaluate each frame at when frames are drawn
+ * on a display's vertical blank. A frame calculated in the vertical blank
+ * callback isn't visible until the *next* vertical blank, so when prediction
+ * is enabled, we use that predicted presentation time (now + the measured
+ * refresh interval) instead of the time of the callback, which removes about
+ * a frame of perceived latency.
+ */
+class PresentationClock
+{
+public:
+    /**
+     * @param shouldPredict true to evaluate at the predicted presentation time.
+     * @param extraLatencyMs additional offset in ms (may be negative) to
+     *        compensate for any latency specific to your app or platform; only
+     *        applied while prediction is enabled.
+     */
+    void setPrediction (bool shouldPredict, int extraLatencyMs = 0)
+    {
+        predict       = shouldPredict;
+        latencyOffset = extraLatencyMs;
+    }
+
+    /**
+     * @return true if prediction is enabled.
+     */
+    bool isPredicting () const { return predict; }
+
+    /**
+     * @brief Calculate the time for the frame we're about to calculate.
+     *
+     * @param now time of the vertical blank callback.
+     * @param refreshRate measured refresh rate in Hz, or <= 0 if it isn't known yet.
+     * @return juce::int64 time in ms; never earlier than the previous frame's.
+     */
+    juce::int64 update (juce::int64 now, float refreshRate);
+
+    /**
+     * @return the time returned by the most recent call to `update()`, or -1.
+     */
+    juce::int64 getFrameTime () const { return frameTime; }
+
+    /**
+     * @brief Forget the previous frame time before starting again.
+     */
+    void reset () { frameTime = -1; }
+
+private:
+    /// @brief should we evaluate at the predicted presentation time?
+    bool predict { false };
+    /// @brief additional latency compensation, in ms.
+    int latencyOffset { 0 };
+    /// @brief time most recently returned from `update()`.
+    juce::int64 frameTime { -1 };
+};
+
 class Controller
 {
 public:
@@ -231,6 +288,30 @@ public:
         return running;
     }
 
+    /**
+     * @brief Evaluate animations at the time each frame will be displayed,
+     * instead of at the time of the vertical blank callback (see
+     * `PresentationClock`).
+     *
+     * @param shouldPredict true to evaluate at the predicted presentation time.
+     * @param extraLatencyMs additional offset in ms (may be negative) to
+     *        compensate for any latency specific to your app or platform; only
+     *        applied while prediction is enabled.
+     */
+    void setPresentationTimePrediction (bool shouldPredict, int extraLatencyMs = 0)
+    {
+        presentation.setPrediction (shouldPredict, extraLatencyMs);
+    }
+
+    /**
+     * @brief Get the time that was passed to the animator on the most recent
+     * frame; if you're pulling values with `Animator::sample()` from inside a
+     * `paint()` call, use this so your values match the ones being pushed.
+     *
+     * @return juce::int64 time in ms, or -1 if we haven't updated yet.
+     */
+    juce::int64 getFrameTime () const { return presentation.getFrameTime (); }
+
 private:
     /// @brief  We'll be updated (via our callback lambda) on each vertical blank
     /// interval of the display that is showing this component.
@@ -241,6 +322,9 @@ private:
 
     FrameRateCalculator frameRate;
     bool running { false };
+
+    /// @brief calculates the time that we pass to the animator.
+    PresentationClock presentation;
 };
 #endif
 /**
@@ -264,7 +348,8 @@ public:
 
     /**
      * @brief Manually advance the animation to a point in time. Each call
-     * to this method must move time forward!
+     * to this method must move time forward, unless the animator is in
+     * timeline mode, where we can move in either direction.
      *
      * @param timeInMs
      * @return false
@@ -273,7 +358,8 @@ public:
 
 private:
     FrameRateCalculator frameRate;
-    bool running { false };
+    /// @brief atomic, because a realtime animator may start us from another thread.
+    std::atomic<bool> running { false };
     juce::int64 lastTime { 0 };
 };
 
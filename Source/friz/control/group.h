@@ -0,0 +1,265 @@
+/*
+    Copyright (c) 2019-2023 Brett g Porter
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+
+#include "animation.h"
+
+namespace friz
+{
+
+/**
+ * @class Group
+ * @brief A container animation object that holds several animations and
+ * executes them at the same time, all driven by the same clock. Finishes when
+ * all of them are done.
+ *
+ * Like `Chain`, the animations in a Group don't need to use the same number
+ * of values, so e.g. a move, a fade, and a scale can be a single animation.
+ * Each animation can start at an offset from the start of the group, either
+ * set explicitly or by setting a stagger time between successive animations.
+ *
+ * @sa Chain
+ */
+class Group : public AnimationType
+{
+public:
+    Group (int id = 0)
+    : AnimationType (id)
+    {
+    }
+
+    /**
+     * @brief Add an animation to the group.
+     *
+     * @param effect the animation to add.
+     * @param offset ms after the start of the group that this animation should
+     *               start (in addition to any stagger)
+     */
+    void addAnimation (std::unique_ptr<AnimationType> effect, int offset = 0)
+    {
+        effect->setCompletionDeferred (isCompletionDeferred ());
+        members.push_back ({ std::move (effect), std::max (0, offset), false, false });
+    }
+
+    /**
+     * @brief Our animations' completions are deferred along with our own.
+     */
+    void setCompletionDeferred (bool shouldDefer) override
+    {
+        AnimationType::setCompletionDeferred (shouldDefer);
+        for (auto& member : members)
+            member.effect->setCompletionDeferred (shouldDefer);
+    }
+
+    void sendDeferredCompletion () override
+    {
+        for (auto& member : members)
+            member.effect->sendDeferredCompletion ();
+        AnimationType::sendDeferredCompletion ();
+    }
+
+    /**
+     * @brief Start each animation `staggerMs` after the one that was added
+     * before it.
+     *
+     * @param staggerMs
+     */
+    void setStagger (int staggerMs) { stagger = std::max (0, staggerMs); }
+
+    AnimationType::Status gotoTime (juce::int64 timeInMs) override
+    {
+        if (finished)
+            return AnimationType::Status::finished;
+
+        if (startTime < 0)
+            setStartTime (timeInMs);
+
+        bool allDone { true };
+        for (size_t i { 0 }; i < members.size (); ++i)
+        {
+            auto& member { members[i] };
+            if (member.done)
+                continue;
+
+            const auto memberStart { getMemberStart (i) };
+            if (timeInMs < memberStart)
+            {
+                allDone = false;
+                continue;
+            }
+
+            if (!member.started)
+            {
+                // start exactly on time, even if that was partway through a frame.
+                member.effect->setStartTime (memberStart);
+                member.started = true;
+            }
+
+            auto status { member.effect->gotoTime (timeInMs) };
+            // if the effect just finished, let it send its completion now instead
+            // of on the next update.
+            if (status != AnimationType::Status::finished && member.effect->isFinished ())
+                status = member.effect->gotoTime (timeInMs);
+
+            member.done = (status == AnimationType::Status::finished);
+            allDone     = allDone && member.done;
+        }
+
+        if (allDone)
+        {
+            finished = true;
+            notifyCompletion (false);
+            return AnimationType::Status::finished;
+        }
+
+        return AnimationType::Status::processing;
+    }
+
+    AnimationType::Status seek (juce::int64 timeInMs) override
+    {
+        if (startTime < 0)
+            setStartTime (timeInMs);
+
+        bool allFinished { true };
+        for (size_t i { 0 }; i < members.size (); ++i)
+        {
+            auto& member { members[i] };
+            member.effect->setStartTime (getMemberStart (i));
+            member.started = true;
+            member.done = (member.effect->seek (timeInMs) == AnimationType::Status::finished);
+            allFinished = allFinished && member.done;
+        }
+
+        // notify each time we cross the end moving forward.
+        if (allFinished && !finished)
+            notifyCompletion (false);
+        finished = allFinished;
+
+        return finished ? AnimationType::Status::finished
+                        : AnimationType::Status::processing;
+    }
+
+    void cancel (bool moveToEndPosition) override
+    {
+        for (auto& member : members)
+        {
+            if (!member.done)
+                member.effect->cancel (moveToEndPosition);
+            member.done = true;
+        }
+
+        notifyCompletion (true);
+        finished = true;
+    }
+
+    bool isFinished () override { return finished; }
+
+    bool isReady () const override
+    {
+        for (const auto& member : members)
+        {
+            if ((nullptr == member.effect) || (!member.effect->isReady ()))
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Retrieve one of the values of our animations, counting through
+     * all of the values of each animation in the order they were added.
+     *
+     * @param index
+     * @return AnimatedValue*
+     */
+    AnimatedValue* getValue (size_t index) override
+    {
+        AnimatedValue* found { nullptr };
+        size_t count { 0 };
+        visitValues (
+            [&] (AnimatedValue& value)
+            {
+                if (count++ == index)
+                    found = &value;
+            });
+        return found;
+    }
+
+    void visitValues (const std::function<void (AnimatedValue&)>& visitor) override
+    {
+        for (auto& member : members)
+            member.effect->visitValues (visitor);
+    }
+
+    juce::int64 getDuration () const override
+    {
+        juce::int64 longest { 0 };
+        for (size_t i { 0 }; i < members.size (); ++i)
+        {
+            const auto duration { members[i].effect->getDuration () };
+            if (duration < 0)
+                return -1;
+            longest = std::max (longest, getMemberOffset (i) + duration);
+        }
+        return preDelay + longest;
+    }
+
+private:
+    /**
+     * @return ms from the start of the group (after any pre-delay) to the start
+     * of one of our animations.
+     */
+    juce::int64 getMemberOffset (size_t index) const
+    {
+        return members[index].offset + static_cast<juce::int64> (index) * stagger;
+    }
+
+    /**
+     * @return time at which one of our animations starts.
+     */
+    juce::int64 getMemberStart (size_t index) const
+    {
+        return startTime + preDelay + getMemberOffset (index);
+    }
+
+private:
+    struct Member
+    {
+        std::unique_ptr<AnimationType> effect;
+        /// @brief explicit start offset in ms.
+        int offset;
+        /// @brief has this animation's start time been set?
+        bool started;
+        /// @brief has this animation finished?
+        bool done;
+    };
+
+    /// @brief the animations that we run together.
+    std::vector<Member> members;
+
+    /// @brief ms between the starts of successive animations.
+    int stagger { 0 };
+
+    /// @brief are all of our animations complete?
+    bool finished { false };
+};
+
+} // namespace friz
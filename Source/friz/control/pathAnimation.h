@@ -0,0 +1,225 @@
+/*
+    Copyright (c) 2019-2023 Brett g Porter
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+
+#include "../curves/parametric.h"
+#include "../curves/pathTable.h"
+#include "animation.h"
+
+namespace friz
+{
+
+/**
+ * @class PathAnimation
+ * @brief Moves a point along a path at an even speed. A single value (which
+ * may use any curve, e.g. `Parametric` or `Spring`) controls progress from
+ * 0 to 1 along the path; each frame that progress is converted to a position
+ * (and optionally the direction of the path at that position) using a
+ * `PathTable`, which can be shared by many animations following the same path.
+ */
+class PathAnimation : public AnimationType
+{
+public:
+    using UpdateFn = std::function<void (int, juce::Point<float>, float)>;
+
+    /**
+     * @brief Construct a new PathAnimation.
+     *
+     * @param path      the path to follow.
+     * @param progress  value that moves from 0 (the start of the path) to 1 (the
+     *                  end); values outside that range are clamped.
+     * @param id        animation ID.
+     */
+    PathAnimation (PathTable::Ptr path, std::unique_ptr<AnimatedValue> progress, int id = 0)
+    : AnimationType { id }
+    , path { std::move (path) }
+    , progress { std::move (progress) }
+    {
+    }
+
+    /**
+     * Set the function that will be called once per frame with the current
+     * position and the angle of the path there, in radians (only calculated
+     * if enabled with `setAngleCalculated()`, otherwise 0).
+     * `updateFn` is public, so you can also just assign to it directly.
+     * @param update UpdateFn function.
+     */
+    void onUpdate (UpdateFn update) { updateFn = update; }
+
+    /**
+     * @brief Also calculate the direction of the path on each frame, e.g. to
+     * rotate a component so it faces the way it's moving.
+     *
+     * @param shouldCalculate
+     */
+    void setAngleCalculated (bool shouldCalculate) { calculateAngle = shouldCalculate; }
+
+    Status gotoTime (juce::int64 timeInMs) override
+    {
+        if (finished)
+        {
+            notifyCompletion (false);
+            return Status::finished;
+        }
+
+        juce::int64 effectElapsed;
+        juce::int64 deltaTime;
+        if (!advanceClock (timeInMs, effectElapsed, deltaTime))
+            return Status::processing;
+
+        const auto position { progress->getNextValue (static_cast<int> (effectElapsed),
+                                                      static_cast<int> (deltaTime)) };
+        sendUpdate (position);
+
+        if (progress->isFinished ())
+            finished = true;
+
+        return Status::processing;
+    }
+
+    Status seek (juce::int64 timeInMs) override
+    {
+        if (startTime < 0)
+            setStartTime (timeInMs);
+        lastTime = timeInMs;
+
+        sendUpdate (progress->seek (static_cast<int> (getEffectElapsed (timeInMs))));
+
+        if (progress->isFinished () && !finished)
+            notifyCompletion (false);
+        finished = progress->isFinished ();
+
+        return finished ? Status::finished : Status::processing;
+    }
+
+    void cancel (bool moveToEndPosition) override
+    {
+        progress->cancel (moveToEndPosition);
+
+        if (moveToEndPosition)
+            sendUpdate (progress->getEndValue ());
+
+        notifyCompletion (true);
+        finished = true;
+    }
+
+    bool isFinished () override { return finished; }
+
+    bool isReady () const override { return path != nullptr && progress != nullptr; }
+
+    /**
+     * @param index only 0 is valid.
+     * @return the value controlling progress along the path.
+     */
+    AnimatedValue* getValue (size_t index) override
+    {
+        if (index == 0)
+            return progress.get ();
+
+        jassertfalse;
+        return nullptr;
+    }
+
+    void visitValues (const std::function<void (AnimatedValue&)>& visitor) override
+    {
+        if (progress != nullptr)
+            visitor (*progress);
+    }
+
+    /**
+     * @brief Sample the position as x, y, and (if `valueCount` is at least 3)
+     * the angle of the path. Only possible if the progress value supports sampling.
+     */
+    bool sample (juce::int64 timeInMs, float* values, size_t valueCount) override
+    {
+        if (valueCount < 2 || !progress->canSample ())
+            return false;
+
+        const auto position { getPosition (
+            progress->valueAt (static_cast<int> (getEffectElapsed (timeInMs)))) };
+        values[0] = position.point.x;
+        values[1] = position.point.y;
+        if (valueCount > 2)
+            values[2] = position.angle;
+        return true;
+    }
+
+    juce::int64 getDuration () const override
+    {
+        const auto duration { progress->getDuration () };
+        return (duration < 0) ? -1 : preDelay + duration;
+    }
+
+private:
+    PathTable::Position getPosition (float progressValue) const
+    {
+        const auto distance { juce::jlimit (0.f, 1.f, progressValue) * path->getLength () };
+        if (calculateAngle)
+            return path->getPosition (distance);
+
+        return { path->getPoint (distance), 0.f };
+    }
+
+    void sendUpdate (float progressValue)
+    {
+        if (updateFn != nullptr)
+        {
+            const auto position { getPosition (progressValue) };
+            updateFn (getId (), position.point, position.angle);
+        }
+    }
+
+public:
+    /// function to call on each frame with the current position.
+    UpdateFn updateFn;
+
+private:
+    PathTable::Ptr path;
+
+    std::unique_ptr<AnimatedValue> progress;
+
+    /// @brief calculate the angle of the path on each frame?
+    bool calculateAngle { false };
+
+    /// is this animation complete?
+    bool finished { false };
+};
+
+/**
+ * @brief Factory function to create an animation that follows a path, easing
+ * along it with one of the `Parametric` curves.
+ *
+ * @param id        Animation ID
+ * @param path      path to follow
+ * @param duration  in ms
+ * @param type      easing curve to use.
+ * @return std::unique_ptr<PathAnimation>
+ */
+inline std::unique_ptr<PathAnimation>
+makePathAnimation (int id, PathTable::Ptr path, int duration,
+                   Parametric::CurveType type = Parametric::kLinear)
+{
+    return std::make_unique<PathAnimation> (
+        std::move (path), std::make_unique<Parametric> (0.f, 1.f, duration, type), id);
+}
+
+} // namespace friz
@@ -0,0 +1,70 @@
+/*
+    Copyright (c) 2019-2023 Brett g Porter
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "repaintCoalescer.h"
+#include "animator.h"
+
+namespace friz
+{
+
+RepaintCoalescer::RepaintCoalescer (juce::Component& hostComponent)
+: host { &hostComponent }
+{
+}
+
+void RepaintCoalescer::attach (Animator& animator)
+{
+    animator.onFrameEnd ([this] (juce::int64) { flush (); });
+}
+
+void RepaintCoalescer::markDirty (juce::Component& component)
+{
+    markDirty (component, component.getLocalBounds ());
+}
+
+void RepaintCoalescer::markDirty (juce::Component& component, juce::Rectangle<int> area)
+{
+    if (auto* hostComponent { host.getComponent () }; hostComponent != nullptr)
+        markDirty (hostComponent->getLocalArea (&component, area));
+}
+
+void RepaintCoalescer::markDirty (juce::Rectangle<int> areaInHost)
+{
+    if (!areaInHost.isEmpty ())
+        dirty.addWithoutMerging (areaInHost);
+}
+
+void RepaintCoalescer::flush ()
+{
+    if (dirty.isEmpty ())
+        return;
+
+    if (auto* hostComponent { host.getComponent () }; hostComponent != nullptr)
+    {
+        for (const auto& area : dirty)
+            hostComponent->repaint (area);
+    }
+
+    dirty.clear ();
+}
+
+} // namespace friz
@@ -0,0 +1,123 @@
+/*
+    Copyright (c) 2019-2023 Brett g Porter
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+namespace friz
+{
+class Animator;
+
+/**
+ * @class RepaintCoalescer
+ * @brief Collects the areas that need to be repainted as animations update
+ * their components during a frame, and repaints them all at once at the end
+ * of the frame.
+ *
+ * Instead of calling `repaint()` from each animation's update callback, call
+ * `markDirty()`; all of the dirty areas are converted to the coordinates of a
+ * host component (typically the one that owns the `Animator`) and collected
+ * without merging them, and `flush()` repaints each of them. Attach the
+ * coalescer to an animator to flush at the end of every frame:
+ *
+ * ```cpp
+ * RepaintCoalescer coalescer { *this };
+ * coalescer.attach (animator);
+ * animation->onUpdate (
+ *     [this] (int, const auto& val)
+ *     {
+ *         coalescer.markDirty (child);   // where it was...
+ *         child.setTopLeftPosition (juce::roundToInt (val[0]), juce::roundToInt (val[1]));
+ *         coalescer.markDirty (child);   // ...and where it is now.
+ *     });
+ * ```
+ *
+ * Use it from the message thread only.
+ */
+class RepaintCoalescer
+{
+public:
+    /**
+     * @param host the component that dirty areas are merged (and repainted) in;
+     *             any component marked dirty should be inside it.
+     */
+    explicit RepaintCoalescer (juce::Component& host);
+
+    /**
+     * @brief Call `flush()` at the end of each of an animator's frames. This
+     * uses the animator's frame end callback (replacing any that was set
+     * before), so the coalescer must stay alive as long as the animator runs,
+     * or be detached with `animator.onFrameEnd (nullptr)`.
+     *
+     * @param animator
+     */
+    void attach (Animator& animator);
+
+    /**
+     * @brief Mark all of a component as needing to be repainted.
+     *
+     * @param component
+     */
+    void markDirty (juce::Component& component);
+
+    /**
+     * @brief Mark part of a component as needing to be repainted.
+     *
+     * @param component
+     * @param area in the component's coordinates.
+     */
+    void markDirty (juce::Component& component, juce::Rectangle<int> area);
+
+    /**
+     * @brief Mark an area of the host component as needing to be repainted.
+     *
+     * @param areaInHost
+     */
+    void markDirty (juce::Rectangle<int> areaInHost);
+
+    /**
+     * @brief Repaint everything that's been marked dirty since the last flush.
+     * Each area is passed to the host's `repaint()` separately; JUCE merges
+     * them when it paints, so we don't pay for merging every time an area is
+     * marked, and areas far apart don't repaint everything between them.
+     */
+    void flush ();
+
+    /**
+     * @return true if anything is waiting to be repainted.
+     */
+    bool isDirty () const { return !dirty.isEmpty (); }
+
+    /**
+     * @return the areas waiting to be repainted, in host coordinates.
+     */
+    const juce::RectangleList<int>& getDirtyAreas () const { return dirty; }
+
+private:
+    /// @brief the component we repaint.
+    juce::Component::SafePointer<juce::Component> host;
+
+    /// @brief areas to repaint, in host coordinates.
+    juce::RectangleList<int> dirty;
+};
+
+} // namespace friz
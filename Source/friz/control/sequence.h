@@ -21,6 +21,7 @@
 */
 #pragma once
 
+#include "../curves/track.h"
 #include "chain.h"
 
 namespace friz
@@ -70,13 +71,84 @@ public:
         effect->completionFn = [this] (int /*id*/, bool wasCanceled)
         {
             // Each effect in the sequence will notify us, but we only pass
-            // along the final one.
-            if ((currentEffect == sequence.size () - 1) && this->completionFn != nullptr)
-                this->completionFn (this->getId (), wasCanceled);
+            // along the final one. (If completions are deferred, we're already
+            // past the end when it arrives.)
+            if (currentEffect >= static_cast<int> (sequence.size ()) - 1)
+                this->notifyCompletion (wasCanceled);
         };
 
         Chain::addAnimation (std::move (effect));
     }
+
+    /**
+     * @brief Flatten this sequence into a single animation with one `TrackValue`
+     * per value, where the boundaries between our effects are calculated once
+     * up front instead of being discovered as each effect finishes. The compiled
+     * animation takes our priority, time scale and tags, calls our update and
+     * completion functions directly, and (unless `releaseFinished` is false)
+     * frees each effect's values as soon as it's played past them.
+     *
+     * Only sequences whose values are all time-based (e.g. `Linear`,
+     * `Parametric`, `KeyframeValue`) can be compiled. On success, the values are
+     * moved out of this sequence, which is left empty.
+     *
+     * @param releaseFinished false to keep every effect's values, e.g. so the
+     *                        compiled animation can be sampled or sought.
+     * @return the compiled animation, or nullptr if we can't be compiled.
+     */
+    std::unique_ptr<Animation<ValueCount>> compile (bool releaseFinished = true)
+    {
+        if (sequence.empty () || !isReady ())
+            return nullptr;
+
+        bool canCompile { true };
+        visitValues ([&canCompile] (AnimatedValue& value)
+                     { canCompile = canCompile && value.canSample (); });
+        if (!canCompile)
+            return nullptr;
+
+        // our pre-delay and the first effect's become the compiled animation's,
+        // and any others become gaps in the tracks.
+        const auto leadIn { sequence.front ()->getDelay () };
+
+        std::array<std::unique_ptr<TrackValue>, ValueCount> tracks;
+        for (auto& track : tracks)
+        {
+            track = std::make_unique<TrackValue> ();
+            track->setReleaseFinished (releaseFinished);
+        }
+
+        int effectStart { -leadIn };
+        for (auto& effect : sequence)
+        {
+            // we only accept Animation<ValueCount> objects in addAnimation().
+            auto* animation { static_cast<Animation<ValueCount>*> (effect.get ()) };
+            const auto effectEnd { effectStart + static_cast<int> (animation->getDuration ()) };
+
+            for (size_t i { 0 }; i < ValueCount; ++i)
+                tracks[i]->addSegment (animation->releaseValue (i),
+                                       effectStart + animation->getDelay (), effectEnd);
+            effectStart = effectEnd;
+        }
+
+        auto compiled { std::make_unique<Animation<ValueCount>> (this->getId ()) };
+        compiled->setDelay (getDelay () + leadIn);
+        for (size_t i { 0 }; i < ValueCount; ++i)
+            compiled->setValue (i, std::move (tracks[i]));
+
+        compiled->setPriority (getPriority ());
+        compiled->setTimeScale (getTimeScale ());
+        compiled->setPaused (isPaused ());
+        compiled->setTags (getTags ());
+
+        compiled->updateFn     = this->updateFn;
+        compiled->completionFn = this->completionFn;
+
+        sequence.clear ();
+        effectOffsets.assign (1, 0);
+        currentEffect = 0;
+        return compiled;
+    }
 };
 
 } // namespace friz
@@ -91,3 +91,494 @@ public:
 };
 
 static Test_Animation testAnimation;
+
+class Test_AnimationSampling : public SubTest
+{
+public:
+    Test_AnimationSampling ()
+    : SubTest ("Animation sampling", "Animation")
+    {
+    }
+
+    void runTest () override
+    {
+        Test ("Sampled values match pushed values",
+              [=]
+              {
+                  float pushed { -1.f };
+                  auto animation { makeAnimation<Linear> (1, 0.f, 100.f, 100) };
+                  animation->setDelay (20);
+                  animation->onUpdate ([&pushed] (int, const Animation<1>::ValueList& val)
+                                       { pushed = val[0]; });
+
+                  // before the animation starts, we see its start value.
+                  Animation<1>::ValueList values;
+                  expect (animation->valueAt (1000, values));
+                  expectWithinAbsoluteError<float> (values[0], 0.f, 0.001f);
+
+                  animation->gotoTime (1000);
+                  // ...and during its pre-delay.
+                  expect (animation->valueAt (1010, values));
+                  expectWithinAbsoluteError<float> (values[0], 0.f, 0.001f);
+
+                  // sampling ahead doesn't disturb the animation.
+                  expect (animation->valueAt (1070, values));
+                  expectWithinAbsoluteError<float> (values[0], 50.f, 0.001f);
+                  expect (animation->valueAt (1200, values));
+                  expectWithinAbsoluteError<float> (values[0], 100.f, 0.001f);
+
+                  for (juce::int64 time { 1020 }; time <= 1120; time += 25)
+                  {
+                      animation->gotoTime (time);
+                      float sampled { -1.f };
+                      expect (animation->sample (time, &sampled, 1));
+                      expectWithinAbsoluteError<float> (sampled, pushed, 0.001f);
+                  }
+                  expect (animation->isFinished ());
+              });
+
+        Test ("Stateful values can't be sampled",
+              [=]
+              {
+                  auto animation { makeAnimation<Spring> (1, 0.f, 100.f, 0.5f, 2.f, 0.5f) };
+                  Animation<1>::ValueList values;
+                  expect (!animation->valueAt (1000, values));
+                  float sampled { -1.f };
+                  expect (!animation->sample (1000, &sampled, 1));
+              });
+
+        Test ("Pulled animation finishes on time",
+              [=]
+              {
+                  bool isComplete { false };
+                  auto animation { makeAnimation<Linear> (1, 0.f, 100.f, 100) };
+                  animation->onCompletion ([&isComplete] (int, bool) { isComplete = true; });
+
+                  // nobody is listening for updates, so values are only sampled.
+                  animation->gotoTime (1000);
+                  animation->gotoTime (1050);
+                  expect (!animation->isFinished ());
+                  float sampled { -1.f };
+                  expect (animation->sample (1050, &sampled, 1));
+                  expectWithinAbsoluteError<float> (sampled, 50.f, 0.001f);
+
+                  animation->gotoTime (1100);
+                  expect (animation->isFinished ());
+                  animation->gotoTime (1110);
+                  expect (isComplete);
+              });
+    }
+};
+
+static Test_AnimationSampling testAnimationSampling;
+
+class Test_TypedAnimation : public SubTest
+{
+public:
+    Test_TypedAnimation ()
+    : SubTest ("TypedAnimation", "Animation")
+    {
+    }
+
+    void runTest () override
+    {
+        Test ("Retarget one lane",
+              [=]
+              {
+                  juce::Point<float> pt { -1.f, -1.f };
+                  auto animation { makeTypedAnimation (1, juce::Point<float> { 0.f, 0.f },
+                                                       juce::Point<float> { 100.f, 100.f },
+                                                       100) };
+                  animation->onUpdate ([&pt] (int, const juce::Point<float>& val)
+                                       { pt = val; });
+                  expect (animation->getValue (0) == nullptr);
+
+                  animation->gotoTime (1000);
+                  animation->gotoTime (1050);
+                  expectWithinAbsoluteError<float> (pt.x, 50.f, 0.001f);
+
+                  // x heads for 200 from where it is now, still finishing on time.
+                  expect (animation->updateTarget (0, 200.f));
+                  expect (!animation->updateTarget (2, 200.f));
+                  animation->gotoTime (1050);
+                  expectWithinAbsoluteError<float> (pt.x, 50.f, 0.001f);
+                  animation->gotoTime (1075);
+                  expectWithinAbsoluteError<float> (pt.x, 125.f, 0.001f);
+                  expectWithinAbsoluteError<float> (pt.y, 75.f, 0.001f);
+                  animation->gotoTime (1100);
+                  expectWithinAbsoluteError<float> (pt.x, 200.f, 0.001f);
+                  expectWithinAbsoluteError<float> (pt.y, 100.f, 0.001f);
+                  expect (animation->isFinished ());
+                  expect (!animation->updateTarget (0, 0.f));
+              });
+
+        Test ("Retarget the whole value",
+              [=]
+              {
+                  juce::Point<float> pt { -1.f, -1.f };
+                  auto animation { makeTypedAnimation (1, juce::Point<float> { 0.f, 0.f },
+                                                       juce::Point<float> { 100.f, 100.f },
+                                                       100, Parametric::kEaseInOutCubic) };
+                  animation->onUpdate ([&pt] (int, const juce::Point<float>& val)
+                                       { pt = val; });
+
+                  animation->gotoTime (1000);
+                  animation->gotoTime (1040);
+                  const auto before { pt };
+
+                  expect (animation->updateTarget (juce::Point<float> { -100.f, 50.f }));
+                  animation->gotoTime (1040);
+                  expectWithinAbsoluteError<float> (pt.x, before.x, 0.001f);
+                  expectWithinAbsoluteError<float> (pt.y, before.y, 0.001f);
+                  animation->gotoTime (1100);
+                  expectWithinAbsoluteError<float> (pt.x, -100.f, 0.001f);
+                  expectWithinAbsoluteError<float> (pt.y, 50.f, 0.001f);
+                  expect (animation->isFinished ());
+              });
+    }
+};
+
+static Test_TypedAnimation testTypedAnimation;
+
+class Test_SequenceCompile : public SubTest
+{
+public:
+    Test_SequenceCompile ()
+    : SubTest ("Sequence compile", "Animation")
+    {
+    }
+
+    void runTest () override
+    {
+        Test ("Compiled playback matches the sequence",
+              [=]
+              {
+                  std::vector<float> expected;
+                  auto sequence { makeSequence (expected) };
+                  std::vector<float> actual;
+                  auto compiled { makeSequence (actual)->compile () };
+                  expect (compiled != nullptr);
+                  expectEquals (compiled->getDuration (), sequence->getDuration ());
+
+                  for (juce::int64 time { 1000 }; time <= 1400; time += 7)
+                  {
+                      const auto updateCount { expected.size () };
+                      sequence->gotoTime (time);
+                      compiled->gotoTime (time);
+
+                      // the compiled animation also updates during the effects'
+                      // pre-delays, holding the previous value.
+                      if (expected.size () > updateCount)
+                      {
+                          expect (!actual.empty ());
+                          expectWithinAbsoluteError<float> (actual.back (), expected.back (),
+                                                            0.001f);
+                      }
+                  }
+                  expect (compiled->isFinished ());
+              });
+
+        Test ("Seek forward after releasing finished effects",
+              [=]
+              {
+                  std::vector<float> expected;
+                  auto sequence { makeSequence (expected) };
+                  std::vector<float> actual;
+                  auto compiled { makeSequence (actual)->compile (true) };
+
+                  // play into the second effect, releasing the first.
+                  for (juce::int64 time { 1000 }; time <= 1170; time += 10)
+                      compiled->gotoTime (time);
+                  sequence->seek (1000);
+
+                  for (juce::int64 time : { 1200, 1230, 1260, 1290 })
+                  {
+                      sequence->seek (time);
+                      compiled->seek (time);
+                      expectWithinAbsoluteError<float> (actual.back (), expected.back (),
+                                                        0.001f);
+                  }
+              });
+
+        Test ("Settings carry over",
+              [=]
+              {
+                  std::vector<float> values;
+                  auto sequence { makeSequence (values) };
+                  sequence->setPriority (AnimationType::Priority::high);
+                  sequence->setTimeScale (0.5f);
+                  sequence->setTags (0x11);
+                  auto compiled { sequence->compile () };
+                  expect (compiled->getPriority () == AnimationType::Priority::high);
+                  expectWithinAbsoluteError<float> (compiled->getTimeScale (), 0.5f, 0.0001f);
+                  expectEquals<juce::uint32> (compiled->getTags (), 0x11);
+              });
+
+        Test ("Stateful values can't be compiled",
+              [=]
+              {
+                  auto sequence { std::make_unique<Sequence<1>> (1) };
+                  sequence->addAnimation (makeAnimation<Linear> (0, 0.f, 1.f, 100));
+                  sequence->addAnimation (makeAnimation<EaseIn> (0, 1.f, 0.f, 0.01f, 0.1f));
+                  expect (sequence->compile () == nullptr);
+              });
+    }
+
+private:
+    /**
+     * @brief Three effects, with a pre-delay on the sequence and on two of
+     * its effects, that send their values to `values`.
+     */
+    static std::unique_ptr<Sequence<1>> makeSequence (std::vector<float>& values)
+    {
+        auto sequence { std::make_unique<Sequence<1>> (1) };
+        sequence->setDelay (20);
+
+        auto first { makeAnimation<Linear> (0, 0.f, 100.f, 100) };
+        first->setDelay (10);
+        sequence->addAnimation (std::move (first));
+
+        auto second { makeAnimation<Parametric> (0, 100.f, 50.f, 50,
+                                                 Parametric::kEaseInOutCubic) };
+        second->setDelay (30);
+        sequence->addAnimation (std::move (second));
+
+        sequence->addAnimation (makeAnimation<Sinusoid> (0, 0.25f, 1.25f, 120));
+
+        sequence->onUpdate ([&values] (int, const Animation<1>::ValueList& val)
+                            { values.push_back (val[0]); });
+        return sequence;
+    }
+};
+
+static Test_SequenceCompile testSequenceCompile;
+
+class Test_Chain : public SubTest
+{
+public:
+    Test_Chain ()
+    : SubTest ("Chain", "Animation")
+    {
+    }
+
+    void runTest () override
+    {
+        Test ("Effects hand off without a gap",
+              [=]
+              {
+                  // three ramps end to end make one continuous ramp from 0 to 300.
+                  float value { -1.f };
+                  bool isComplete { false };
+                  auto sequence { std::make_unique<Sequence<1>> (1) };
+                  for (int i { 0 }; i < 3; ++i)
+                  {
+                      sequence->addAnimation (makeAnimation<Linear> (
+                          0, 100.f * static_cast<float> (i), 100.f * static_cast<float> (i + 1),
+                          100));
+                  }
+                  sequence->onUpdate ([&value] (int, const Animation<1>::ValueList& val)
+                                      { value = val[0]; });
+                  sequence->onCompletion ([&isComplete] (int, bool) { isComplete = true; });
+
+                  // ~30 Hz frames, which land partway through each effect.
+                  juce::int64 time { 0 };
+                  for (; time < 300; time += 33)
+                  {
+                      expect (sequence->gotoTime (time) == AnimationType::Status::processing);
+                      expectWithinAbsoluteError<float> (value, static_cast<float> (time),
+                                                        0.001f);
+                  }
+                  expect (!isComplete);
+
+                  // finishes (and reports it) on the first frame past the end.
+                  expect (sequence->gotoTime (time) == AnimationType::Status::finished);
+                  expectWithinAbsoluteError<float> (value, 300.f, 0.001f);
+                  expect (isComplete);
+              });
+
+        Test ("Several effects in one frame",
+              [=]
+              {
+                  std::vector<int> completed;
+                  Chain chain;
+                  for (int id : { 1, 2, 3 })
+                  {
+                      auto effect { makeAnimation<Linear> (id, 0.f, 1.f, 10) };
+                      effect->onCompletion ([&completed] (int effectId, bool)
+                                            { completed.push_back (effectId); });
+                      chain.addAnimation (std::move (effect));
+                  }
+                  expectEquals (chain.getDuration (), juce::int64 { 30 });
+
+                  expect (chain.gotoTime (0) == AnimationType::Status::processing);
+                  expect (chain.gotoTime (25) == AnimationType::Status::processing);
+                  expect (completed == std::vector<int> ({ 1, 2 }));
+                  expect (chain.gotoTime (30) == AnimationType::Status::finished);
+                  expect (completed == std::vector<int> ({ 1, 2, 3 }));
+              });
+    }
+};
+
+static Test_Chain testChain;
+
+class Test_Group : public SubTest
+{
+public:
+    Test_Group ()
+    : SubTest ("Group", "Animation")
+    {
+    }
+
+    void runTest () override
+    {
+        Test ("Members run together with their offsets",
+              [=]
+              {
+                  float move { -1.f };
+                  std::array<float, 2> scale { -1.f, -1.f };
+                  int completionCount { 0 };
+
+                  auto moveEffect { makeAnimation<Linear> (0, 0.f, 100.f, 100) };
+                  moveEffect->onUpdate ([&move] (int, const Animation<1>::ValueList& val)
+                                        { move = val[0]; });
+                  auto scaleEffect { makeAnimation<Linear, 2> (0, { 1.f, 1.f }, { 2.f, 3.f },
+                                                               50) };
+                  scaleEffect->onUpdate ([&scale] (int, const Animation<2>::ValueList& val)
+                                         { scale = val; });
+
+                  Group group { 1 };
+                  group.addAnimation (std::move (moveEffect));
+                  group.addAnimation (std::move (scaleEffect), 20);
+                  group.setStagger (10);
+                  group.onCompletion ([&completionCount] (int, bool) { ++completionCount; });
+                  // the scale starts at 30 (offset + stagger) and ends at 80.
+                  expectEquals (group.getDuration (), juce::int64 { 100 });
+
+                  expect (group.gotoTime (1000) == AnimationType::Status::processing);
+                  expectWithinAbsoluteError<float> (move, 0.f, 0.001f);
+                  expectWithinAbsoluteError<float> (scale[0], -1.f, 0.001f);
+
+                  group.gotoTime (1055);
+                  expectWithinAbsoluteError<float> (move, 55.f, 0.001f);
+                  expectWithinAbsoluteError<float> (scale[0], 1.5f, 0.001f);
+                  expectWithinAbsoluteError<float> (scale[1], 2.f, 0.001f);
+
+                  group.gotoTime (1090);
+                  expectWithinAbsoluteError<float> (scale[1], 3.f, 0.001f);
+                  expectEquals (completionCount, 0);
+
+                  expect (group.gotoTime (1100) == AnimationType::Status::finished);
+                  expectWithinAbsoluteError<float> (move, 100.f, 0.001f);
+                  expectEquals (completionCount, 1);
+                  group.gotoTime (1110);
+                  expectEquals (completionCount, 1);
+              });
+
+        Test ("Values are numbered across members",
+              [=]
+              {
+                  Group group;
+                  group.addAnimation (makeAnimation<Linear> (0, 0.f, 1.f, 10));
+                  group.addAnimation (
+                      makeAnimation<Linear, 2> (0, { 5.f, 6.f }, { 7.f, 8.f }, 10));
+
+                  auto* value { group.getValue (2) };
+                  expect (value != nullptr);
+                  if (value != nullptr)
+                      expectWithinAbsoluteError<float> (value->getEndValue (), 8.f, 0.001f);
+                  expect (group.getValue (3) == nullptr);
+              });
+
+        Test ("Cancel",
+              [=]
+              {
+                  float value { -1.f };
+                  bool wasCanceled { false };
+                  auto effect { makeAnimation<Linear> (0, 0.f, 100.f, 100) };
+                  effect->onUpdate ([&value] (int, const Animation<1>::ValueList& val)
+                                    { value = val[0]; });
+
+                  Group group;
+                  group.addAnimation (std::move (effect));
+                  group.onCompletion ([&wasCanceled] (int, bool canceled)
+                                      { wasCanceled = canceled; });
+                  group.gotoTime (0);
+                  group.gotoTime (10);
+                  group.cancel (true);
+                  expectWithinAbsoluteError<float> (value, 100.f, 0.001f);
+                  expect (wasCanceled);
+                  expect (group.isFinished ());
+              });
+    }
+};
+
+static Test_Group testGroup;
+
+class Test_StaggeredAnimations : public SubTest
+{
+public:
+    Test_StaggeredAnimations ()
+    : SubTest ("Staggered animations", "Animation")
+    {
+    }
+
+    void runTest () override
+    {
+        Test ("Each animation starts after the one before",
+              [=]
+              {
+                  const auto spec { CurveSpec::create (Parametric::kLinear, 100) };
+                  auto animations { makeStaggeredAnimations<2> (spec, 4, 10, { 0.f, 100.f },
+                                                                { 100.f, 0.f }, 25) };
+                  expectEquals (static_cast<int> (animations.size ()), 4);
+                  // one spec for all of them.
+                  expectEquals (static_cast<int> (spec.use_count ()), 1 + 4 * 2);
+
+                  std::array<std::array<float, 2>, 4> values {};
+                  for (size_t i { 0 }; i < animations.size (); ++i)
+                  {
+                      auto& animation { animations[i] };
+                      expectEquals (animation->getId (), 10 + static_cast<int> (i));
+                      expectEquals (animation->getDelay (), 25 * static_cast<int> (i));
+                      animation->onUpdate (
+                          [&values, i] (int, const Animation<2>::ValueList& val)
+                          { values[i] = val; });
+                  }
+
+                  for (juce::int64 time : { 1000, 1050 })
+                  {
+                      for (auto& animation : animations)
+                          animation->gotoTime (time);
+                  }
+                  for (size_t i { 0 }; i < 3; ++i)
+                  {
+                      const auto expected { 50.f - 25.f * static_cast<float> (i) };
+                      expectWithinAbsoluteError<float> (values[i][0], expected, 0.001f);
+                      expectWithinAbsoluteError<float> (values[i][1], 100.f - expected,
+                                                        0.001f);
+                  }
+
+                  // the last one is still waiting, and finishes last.
+                  expectWithinAbsoluteError<float> (values[3][0], 0.f, 0.001f);
+                  for (auto& animation : animations)
+                      animation->gotoTime (1160);
+                  expect (!animations[3]->isFinished ());
+                  for (size_t i { 0 }; i < 3; ++i)
+                      expect (animations[i]->isFinished ());
+              });
+
+        Test ("Cancel",
+              [=]
+              {
+                  auto animations { makeStaggeredAnimations<1> (
+                      CurveSpec::create (Parametric::kLinear, 100), 2, 1, { 0.f }, { 1.f }, 50) };
+                  for (auto& animation : animations)
+                      animation->gotoTime (1000);
+                  animations[1]->cancel (false);
+                  expect (animations[1]->isFinished ());
+                  expect (!animations[0]->isFinished ());
+              });
+    }
+};
+
+static Test_StaggeredAnimations testStaggeredAnimations;
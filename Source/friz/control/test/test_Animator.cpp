@@ -95,3 +95,1322 @@ private:
 };
 
 static Test_Animator testAnimator;
+
+/**
+ * @brief Base for tests that drive an animator's clock by hand with an
+ * `AsyncController`.
+ */
+class AnimatorTest : public SubTest
+{
+public:
+    AnimatorTest (const char* name)
+    : SubTest (name, "Animator")
+    {
+    }
+
+    void Setup () override
+    {
+        fAnimator = std::make_unique<Animator> (std::make_unique<AsyncController> ());
+    }
+
+    void TearDown () override { fAnimator.reset (nullptr); }
+
+protected:
+    /**
+     * @brief Run one frame of the animator at this time.
+     */
+    void gotoTime (juce::int64 timeInMs)
+    {
+        static_cast<AsyncController*> (fAnimator->getController ())->gotoTime (timeInMs);
+    }
+
+    /**
+     * @brief Make a one-value animation that stores its values in `value`.
+     */
+    std::unique_ptr<Animation<1>> makeRamp (int id, float& value, int duration = 100)
+    {
+        auto animation { makeAnimation<Linear> (id, 0.f, 100.f, duration) };
+        animation->onUpdate ([&value] (int, const Animation<1>::ValueList& val)
+                             { value = val[0]; });
+        return animation;
+    }
+
+    std::unique_ptr<Animator> fAnimator;
+};
+
+/**
+ * @brief Tests of changing where running typed animations are headed.
+ */
+class Test_AnimatorTypedRetarget : public AnimatorTest
+{
+public:
+    Test_AnimatorTypedRetarget ()
+    : AnimatorTest ("Animator typed retarget")
+    {
+    }
+
+    void runTest () override
+    {
+        Test ("Retarget a typed animation",
+              [=]
+              {
+                  juce::Rectangle<float> rect;
+                  auto animation { makeTypedAnimation (
+                      1, juce::Rectangle<float> { 0.f, 0.f, 10.f, 10.f },
+                      juce::Rectangle<float> { 100.f, 0.f, 10.f, 10.f }, 100) };
+                  animation->onUpdate ([&rect] (int, const juce::Rectangle<float>& val)
+                                       { rect = val; });
+                  expect (fAnimator->addAnimation (std::move (animation)));
+
+                  gotoTime (1000);
+                  gotoTime (1050);
+                  // lanes are x, y, width, height.
+                  expect (fAnimator->updateTarget (1, 1, 50.f));
+                  expect (!fAnimator->updateTarget (2, 1, 50.f));
+                  gotoTime (1075);
+                  expectWithinAbsoluteError<float> (rect.getX (), 75.f, 0.001f);
+                  expectWithinAbsoluteError<float> (rect.getY (), 25.f, 0.001f);
+                  gotoTime (1100);
+                  expectWithinAbsoluteError<float> (rect.getX (), 100.f, 0.001f);
+                  expectWithinAbsoluteError<float> (rect.getY (), 50.f, 0.001f);
+              });
+    }
+};
+
+static Test_AnimatorTypedRetarget testAnimatorTypedRetarget;
+
+/**
+ * @brief Tests of animations added in realtime mode, where the animator never
+ * locks, allocates, or calls completion callbacks on the thread that updates it.
+ */
+class Test_AnimatorRealtime : public AnimatorTest
+{
+public:
+    Test_AnimatorRealtime ()
+    : AnimatorTest ("Animator realtime")
+    {
+    }
+
+    void Setup () override
+    {
+        AnimatorTest::Setup ();
+        fAnimator->enableRealtimeMode (4);
+    }
+
+    void runTest () override
+    {
+        Test ("Updates run, completions wait for the message thread",
+              [=]
+              {
+                  float value { -1.f };
+                  bool isComplete { false };
+                  auto animation { makeRamp (1, value) };
+                  animation->onCompletion ([&isComplete] (int, bool) { isComplete = true; });
+                  expect (fAnimator->addAnimation (std::move (animation)));
+
+                  gotoTime (1000);
+                  expectWithinAbsoluteError<float> (value, 0.f, 0.001f);
+                  gotoTime (1100);
+                  expectWithinAbsoluteError<float> (value, 100.f, 0.001f);
+                  gotoTime (1110);
+                  expect (!isComplete);
+
+                  // deleting the animator reaps any retired animations.
+                  fAnimator.reset ();
+                  expect (isComplete);
+              });
+
+        Test ("Chain effect completions are deferred",
+              [=]
+              {
+                  int completionCount { 0 };
+                  auto chain { std::make_unique<Chain> (1) };
+                  for (int id : { 1, 2 })
+                  {
+                      auto effect { makeAnimation<Linear> (id, 0.f, 1.f, 50) };
+                      effect->onCompletion ([&completionCount] (int, bool)
+                                            { ++completionCount; });
+                      chain->addAnimation (std::move (effect));
+                  }
+                  expect (fAnimator->addAnimation (std::move (chain)));
+
+                  for (juce::int64 time { 1000 }; time <= 1250; time += 25)
+                      gotoTime (time);
+                  expectEquals (completionCount, 0);
+
+                  fAnimator.reset ();
+                  expectEquals (completionCount, 2);
+              });
+    }
+};
+
+static Test_AnimatorRealtime testAnimatorRealtime;
+
+/**
+ * @brief Tests of animations with a pre-delay, which wait in the animator's
+ * delay queue instead of being updated every frame.
+ */
+class Test_AnimatorDelay : public AnimatorTest
+{
+public:
+    Test_AnimatorDelay ()
+    : AnimatorTest ("Animator delay")
+    {
+    }
+
+    void runTest () override
+    {
+        Test ("Delayed animations start in order",
+              [=]
+              {
+                  std::vector<int> started;
+                  for (int id : { 1, 2, 3 })
+                  {
+                      // added in the reverse of the order they'll start.
+                      auto animation { makeAnimation<Linear> (id, 0.f, 1.f, 100) };
+                      animation->setDelay (100 - 25 * id);
+                      animation->onUpdate (
+                          [&started] (int animId, const Animation<1>::ValueList&)
+                          {
+                              if (std::find (started.begin (), started.end (), animId) ==
+                                  started.end ())
+                                  started.push_back (animId);
+                          });
+                      fAnimator->addAnimation (std::move (animation));
+                  }
+
+                  for (juce::int64 time { 1000 }; time <= 1100; time += 10)
+                      gotoTime (time);
+
+                  expectEquals (static_cast<int> (started.size ()), 3);
+                  expect (started == std::vector<int> ({ 3, 2, 1 }));
+              });
+
+        Test ("Canceling a delayed animation keeps the rest in order",
+              [=]
+              {
+                  std::vector<int> started;
+                  for (int id : { 1, 2, 3, 4, 5 })
+                  {
+                      auto animation { makeAnimation<Linear> (id, 0.f, 1.f, 100) };
+                      animation->setDelay (10 * ((id * 3) % 5 + 1));
+                      animation->onUpdate (
+                          [&started] (int animId, const Animation<1>::ValueList&)
+                          {
+                              if (std::find (started.begin (), started.end (), animId) ==
+                                  started.end ())
+                                  started.push_back (animId);
+                          });
+                      fAnimator->addAnimation (std::move (animation));
+                  }
+
+                  // delays are 40, 20, 50, 30, 10
+                  gotoTime (1000);
+                  expect (fAnimator->cancelAnimation (4, false));
+                  for (juce::int64 time { 1005 }; time <= 1100; time += 10)
+                      gotoTime (time);
+                  expect (started == std::vector<int> ({ 5, 2, 1, 3 }));
+              });
+
+        Test ("Delayed animation starts at its start value",
+              [=]
+              {
+                  float value { -1.f };
+                  auto animation { makeAnimation<Linear> (1, 0.f, 100.f, 100) };
+                  animation->setDelay (50);
+                  animation->onUpdate ([&value] (int, const Animation<1>::ValueList& val)
+                                       { value = val[0]; });
+                  fAnimator->addAnimation (std::move (animation));
+
+                  gotoTime (1000);
+                  gotoTime (1040);
+                  expectWithinAbsoluteError<float> (value, -1.f, 0.001f);
+                  gotoTime (1050);
+                  expectWithinAbsoluteError<float> (value, 0.f, 0.001f);
+                  gotoTime (1100);
+                  expectWithinAbsoluteError<float> (value, 50.f, 0.001f);
+              });
+
+        Test ("Delayed sequence",
+              [=]
+              {
+                  std::vector<float> values;
+                  bool isComplete { false };
+                  auto sequence { std::make_unique<Sequence<1>> (1) };
+                  sequence->addAnimation (makeAnimation<Linear> (0, 0.f, 100.f, 100));
+                  sequence->addAnimation (makeAnimation<Linear> (0, 100.f, 0.f, 100));
+                  sequence->setDelay (50);
+                  sequence->onUpdate ([&values] (int, const Animation<1>::ValueList& val)
+                                      { values.push_back (val[0]); });
+                  sequence->onCompletion ([&isComplete] (int, bool) { isComplete = true; });
+                  expectEquals (sequence->getDuration (), juce::int64 { 250 });
+                  fAnimator->addAnimation (std::move (sequence));
+
+                  gotoTime (1000);
+                  expect (values.empty ());
+                  gotoTime (1050);
+                  expectEquals (static_cast<int> (values.size ()), 1);
+                  expectWithinAbsoluteError<float> (values.back (), 0.f, 0.001f);
+                  gotoTime (1100);
+                  expectWithinAbsoluteError<float> (values.back (), 50.f, 0.001f);
+                  gotoTime (1200);
+                  expectWithinAbsoluteError<float> (values.back (), 50.f, 0.001f);
+                  expect (!isComplete);
+                  gotoTime (1250);
+                  expectWithinAbsoluteError<float> (values.back (), 0.f, 0.001f);
+                  expect (isComplete);
+              });
+    }
+
+};
+
+static Test_AnimatorDelay testAnimatorDelay;
+
+/**
+ * @brief Tests of physics values stepped together by the animator's shared
+ * integrator, which should behave exactly as they do when stepped one by one.
+ */
+class Test_AnimatorBatchedPhysics : public AnimatorTest
+{
+public:
+    Test_AnimatorBatchedPhysics ()
+    : AnimatorTest ("Animator batched physics")
+    {
+    }
+
+    void runTest () override
+    {
+        Test ("Batched values match individual ones",
+              [=]
+              {
+                  const auto batched { run (true) };
+                  const auto individual { run (false) };
+                  expectEquals (batched.size (), individual.size ());
+                  for (size_t i { 0 }; i < std::min (batched.size (), individual.size ()); ++i)
+                  {
+                      for (size_t v { 0 }; v < 3; ++v)
+                          expectWithinAbsoluteError<float> (batched[i][v], individual[i][v],
+                                                            0.001f);
+                  }
+              });
+
+        Test ("Batched values can be retargeted",
+              [=]
+              {
+                  fAnimator->setBatchedPhysics (true);
+                  float value { 0.f };
+                  auto animation { makeAnimation<SmoothedValue> (1, 0.f, 100.f, 0.01f, 0.1f) };
+                  animation->onUpdate ([&value] (int, const Animation<1>::ValueList& val)
+                                       { value = val[0]; });
+                  fAnimator->addAnimation (std::move (animation));
+
+                  gotoTime (1000);
+                  gotoTime (1010);
+                  const auto before { value };
+                  expect (fAnimator->updateTarget (1, 0, -100.f));
+                  gotoTime (1020);
+                  expect (value < before);
+                  for (juce::int64 time { 1030 }; time < 2000; time += 10)
+                      gotoTime (time);
+                  expectWithinAbsoluteError<float> (value, -100.f, 0.01f);
+              });
+    }
+
+private:
+    /**
+     * @brief Run a spring and the two easing curves, and record their values
+     * at each frame until they finish.
+     */
+    std::vector<std::array<float, 3>> run (bool batchPhysics)
+    {
+        Setup ();
+        fAnimator->setBatchedPhysics (batchPhysics);
+
+        std::vector<std::array<float, 3>> frames;
+        auto animation { std::make_unique<Animation<3>> (1) };
+        animation->setValue (0, std::make_unique<Spring> (0.f, 100.f, 0.5f, 0.5f, 0.7f));
+        animation->setValue (1, std::make_unique<EaseIn> (0.f, 100.f, 0.5f, 0.05f));
+        animation->setValue (2, std::make_unique<EaseOut> (100.f, 0.f, 0.5f, 1.01f));
+        animation->onUpdate ([&frames] (int, const Animation<3>::ValueList& val)
+                             { frames.push_back (val); });
+        fAnimator->addAnimation (std::move (animation));
+
+        // uneven frame times, to step the integrator by different amounts.
+        juce::int64 time { 1000 };
+        for (int frame { 0 }; frame < 200 && fAnimator->getAnimation (1) != nullptr; ++frame)
+        {
+            gotoTime (time);
+            time += 10 + frame % 7;
+        }
+        expect (fAnimator->getAnimation (1) == nullptr);
+
+        TearDown ();
+        return frames;
+    }
+};
+
+static Test_AnimatorBatchedPhysics testAnimatorBatchedPhysics;
+
+/**
+ * @brief Tests of timeline mode, where the animator can be moved back and
+ * forth through its animations.
+ */
+class Test_AnimatorTimeline : public AnimatorTest
+{
+public:
+    Test_AnimatorTimeline ()
+    : AnimatorTest ("Animator timeline")
+    {
+    }
+
+    void Setup () override
+    {
+        AnimatorTest::Setup ();
+        fAnimator->setTimelineMode (true, 50);
+    }
+
+    void runTest () override
+    {
+        Test ("Scrub a sequence",
+              [=]
+              {
+                  float value { -1.f };
+                  int completionCount { 0 };
+                  auto sequence { std::make_unique<Sequence<1>> (1) };
+                  sequence->addAnimation (makeAnimation<Linear> (0, 0.f, 100.f, 100));
+                  sequence->addAnimation (makeAnimation<Linear> (0, 100.f, 0.f, 100));
+                  sequence->onUpdate ([&value] (int, const Animation<1>::ValueList& val)
+                                      { value = val[0]; });
+                  sequence->onCompletion ([&completionCount] (int, bool)
+                                          { ++completionCount; });
+                  fAnimator->addAnimation (std::move (sequence));
+                  expectEquals (fAnimator->getTimelineDuration (), juce::int64 { 200 });
+
+                  gotoTime (150);
+                  expectWithinAbsoluteError<float> (value, 50.f, 0.001f);
+                  gotoTime (25);
+                  expectWithinAbsoluteError<float> (value, 25.f, 0.001f);
+                  gotoTime (200);
+                  expectWithinAbsoluteError<float> (value, 0.f, 0.001f);
+                  expectEquals (completionCount, 1);
+
+                  // finished animations stay on the timeline...
+                  gotoTime (100);
+                  expectWithinAbsoluteError<float> (value, 100.f, 0.001f);
+                  expect (fAnimator->getAnimation (1) != nullptr);
+                  // ...and complete again each time we cross the end.
+                  gotoTime (250);
+                  expectEquals (completionCount, 2);
+              });
+
+        Test ("Physics values go back to checkpoints",
+              [=]
+              {
+                  float value { 0.f };
+                  auto animation { makeAnimation<Spring> (1, 0.f, 100.f, 0.01f, 0.5f, 0.9f) };
+                  animation->onUpdate ([&value] (int, const Animation<1>::ValueList& val)
+                                       { value = val[0]; });
+                  fAnimator->addAnimation (std::move (animation));
+                  expectEquals (fAnimator->getTimelineDuration (), juce::int64 { -1 });
+
+                  std::vector<float> forward;
+                  for (juce::int64 time { 0 }; time <= 300; time += 10)
+                  {
+                      gotoTime (time);
+                      forward.push_back (value);
+                  }
+
+                  // going back (to times between checkpoints) matches going forward.
+                  for (juce::int64 time : { 170, 30, 290, 0, 120 })
+                  {
+                      gotoTime (time);
+                      expectWithinAbsoluteError<float> (
+                          value, forward[static_cast<size_t> (time / 10)], 0.0001f);
+                  }
+              });
+    }
+};
+
+static Test_AnimatorTimeline testAnimatorTimeline;
+
+/**
+ * @brief Tests of changing the targets of many animations at once.
+ */
+class Test_AnimatorBatchedTargets : public AnimatorTest
+{
+public:
+    Test_AnimatorBatchedTargets ()
+    : AnimatorTest ("Animator batched targets")
+    {
+    }
+
+    void runTest () override
+    {
+        Test ("Changes go to the right values, in order",
+              [=]
+              {
+                  std::array<float, 3> values { 0.f, 0.f, 0.f };
+                  for (int id : { 1, 2, 3 })
+                      fAnimator->addAnimation (
+                          makeSmoothed<1> (id, { 100.f }, &values[static_cast<size_t> (id - 1)]));
+
+                  std::array<float, 2> pair { 0.f, 0.f };
+                  fAnimator->addAnimation (makeSmoothed<2> (4, { 100.f, 100.f }, pair.data ()));
+                  gotoTime (1000);
+
+                  // not sorted by ID; two changes to the same value; an ID that
+                  // doesn't exist.
+                  const std::vector<Animator::TargetUpdate> updates {
+                      { 3, 0, 30.f }, { 1, 0, 10.f }, { 4, 1, 40.f }, { 3, 0, 300.f },
+                      { 99, 0, 1.f }
+                  };
+                  expectEquals (fAnimator->updateTargets (updates), 4);
+
+                  // already sorted.
+                  const std::vector<Animator::TargetUpdate> sorted { { 2, 0, 20.f },
+                                                                     { 4, 0, -40.f } };
+                  expectEquals (fAnimator->updateTargets (sorted), 2);
+
+                  settle ();
+                  expectWithinAbsoluteError<float> (values[0], 10.f, 0.02f);
+                  expectWithinAbsoluteError<float> (values[1], 20.f, 0.02f);
+                  expectWithinAbsoluteError<float> (values[2], 300.f, 0.02f);
+                  expectWithinAbsoluteError<float> (pair[0], -40.f, 0.02f);
+                  expectWithinAbsoluteError<float> (pair[1], 40.f, 0.02f);
+              });
+
+        Test ("All the values of one animation",
+              [=]
+              {
+                  std::array<float, 2> pair { 0.f, 0.f };
+                  fAnimator->addAnimation (makeSmoothed<2> (1, { 100.f, 100.f }, pair.data ()));
+                  gotoTime (1000);
+
+                  expectEquals (fAnimator->updateTargets (1, std::array<float, 2> { 5.f, 6.f }), 2);
+                  expectEquals (fAnimator->updateTargets (2, std::array<float, 2> { 5.f, 6.f }), 0);
+                  settle ();
+                  expectWithinAbsoluteError<float> (pair[0], 5.f, 0.02f);
+                  expectWithinAbsoluteError<float> (pair[1], 6.f, 0.02f);
+              });
+    }
+
+private:
+    /**
+     * @brief Make an animation of smoothed values (which accept new targets)
+     * that copies its values to `out`.
+     */
+    template <int ValueCount>
+    std::unique_ptr<Animation<ValueCount>> makeSmoothed (int id,
+                                                         std::array<float, ValueCount> targets,
+                                                         float* out)
+    {
+        auto animation { makeAnimation<SmoothedValue, ValueCount> (
+            id, std::array<float, ValueCount> {}, std::move (targets), 0.01f, 0.5f) };
+        animation->onUpdate (
+            [out] (int, const typename Animation<ValueCount>::ValueList& val)
+            { std::copy (val.begin (), val.end (), out); });
+        return animation;
+    }
+
+    /**
+     * @brief Run frames until the smoothed values have had time to reach their targets.
+     */
+    void settle ()
+    {
+        for (juce::int64 time { 1010 }; time < 1500; time += 10)
+            gotoTime (time);
+    }
+};
+
+static Test_AnimatorBatchedTargets testAnimatorBatchedTargets;
+
+/**
+ * @brief Tests of changing an animation's target while it's running.
+ */
+class Test_AnimatorRetarget : public AnimatorTest
+{
+public:
+    Test_AnimatorRetarget ()
+    : AnimatorTest ("Animator retarget")
+    {
+    }
+
+    void runTest () override
+    {
+        Test ("Timed value blends into its new target",
+              [=]
+              {
+                  float value { 0.f };
+                  fAnimator->addAnimation (makeRamp (1, value));
+                  for (juce::int64 time { 1000 }; time <= 1050; time += 10)
+                      gotoTime (time);
+                  expectWithinAbsoluteError<float> (value, 50.f, 0.001f);
+
+                  expect (fAnimator->updateTarget (1, 0, 200.f));
+                  // no jump, and still moving at about the same speed...
+                  gotoTime (1051);
+                  expectWithinAbsoluteError<float> (value, 51.f, 0.1f);
+                  // ...but arriving at the new target on time.
+                  gotoTime (1100);
+                  expectWithinAbsoluteError<float> (value, 200.f, 0.001f);
+              });
+
+        Test ("Sampled values blend from the current time",
+              [=]
+              {
+                  // nobody listens for updates, so the values are only pulled.
+                  fAnimator->addAnimation (makeAnimation<Linear> (1, 0.f, 100.f, 100));
+                  for (juce::int64 time { 1000 }; time <= 1050; time += 10)
+                      gotoTime (time);
+
+                  std::array<float, 1> before;
+                  expect (fAnimator->sample (1, 1050, before));
+                  expect (fAnimator->updateTarget (1, 0, 200.f));
+                  std::array<float, 1> after;
+                  expect (fAnimator->sample (1, 1050, after));
+                  expectWithinAbsoluteError<float> (after[0], before[0], 0.001f);
+                  expect (fAnimator->sample (1, 1100, after));
+                  expectWithinAbsoluteError<float> (after[0], 200.f, 0.001f);
+              });
+
+        Test ("Physics value heads for its new target",
+              [=]
+              {
+                  float value { 0.f };
+                  auto animation { makeAnimation<Spring> (1, 0.f, 100.f, 0.01f, 0.5f, 0.9f) };
+                  animation->onUpdate ([&value] (int, const Animation<1>::ValueList& val)
+                                       { value = val[0]; });
+                  fAnimator->addAnimation (std::move (animation));
+                  gotoTime (1000);
+                  gotoTime (1020);
+
+                  expect (fAnimator->updateTarget (1, 0, -50.f));
+                  for (juce::int64 time { 1030 }; time < 3000; time += 10)
+                      gotoTime (time);
+                  expectWithinAbsoluteError<float> (value, -50.f, 0.01f);
+              });
+
+        Test ("Values with a fixed shape can't be retargeted",
+              [=]
+              {
+                  Sinusoid wave { 0, 4, 100 };
+                  wave.getNextValue (10, 10);
+                  expect (!wave.updateTarget (0.5f));
+              });
+
+        Test ("Finished physics values still accept a target",
+              [=]
+              {
+                  SmoothedValue value { 0.f, 1.f, 0.5f, 0.9f };
+                  value.getNextValue (0, 0);
+                  value.getNextValue (1, 1);
+                  expect (value.isFinished ());
+
+                  // as it always has, but we don't start moving again.
+                  expect (value.updateTarget (10.f));
+                  expectWithinAbsoluteError<float> (value.getEndValue (), 10.f, 0.001f);
+                  expect (value.isFinished ());
+              });
+    }
+};
+
+static Test_AnimatorRetarget testAnimatorRetarget;
+
+/**
+ * @brief Tests of animation priorities when the animator is over its frame
+ * budget. The budget is set so small that every frame is over it.
+ */
+class Test_AnimatorBudget : public AnimatorTest
+{
+public:
+    Test_AnimatorBudget ()
+    : AnimatorTest ("Animator frame budget")
+    {
+    }
+
+    void runTest () override
+    {
+        Test ("Reduce rate by priority",
+              [=]
+              {
+                  fAnimator->setFrameBudget (kTinyBudget, Animator::Degradation::reduceRate, 2);
+                  std::array<int, 3> updateCounts { 0, 0, 0 };
+                  addCounted (AnimationType::Priority::low, updateCounts[0]);
+                  addCounted (AnimationType::Priority::normal, updateCounts[1]);
+                  addCounted (AnimationType::Priority::high, updateCounts[2]);
+
+                  // the first frame over budget degrades low priority animations,
+                  // the second normal ones too; each then runs every other frame.
+                  for (int frame { 0 }; frame < 10; ++frame)
+                      gotoTime (1000 + frame * 10);
+
+                  expectEquals (updateCounts[0], 5);
+                  expectEquals (updateCounts[1], 6);
+                  expectEquals (updateCounts[2], 10);
+
+                  const auto stats { fAnimator->getBudgetStats () };
+                  expectEquals (stats.framesOverBudget, 10);
+                  expectEquals (stats.framesDegraded, 9);
+                  expectEquals (stats.updatesSkipped, 9);
+                  expectEquals (stats.animationsSnapped, 0);
+
+                  // with a budget we can meet, everything runs at full rate.
+                  fAnimator->resetBudgetStats ();
+                  fAnimator->setFrameBudget (1000.0, Animator::Degradation::reduceRate, 2);
+                  for (int frame { 10 }; frame < 20; ++frame)
+                      gotoTime (1000 + frame * 10);
+                  expectEquals (updateCounts[0], 15);
+                  expectEquals (fAnimator->getBudgetStats ().framesOverBudget, 0);
+                  expectEquals (fAnimator->getBudgetStats ().framesDegraded, 0);
+              });
+
+        Test ("Snap low priority to end",
+              [=]
+              {
+                  fAnimator->setFrameBudget (kTinyBudget, Animator::Degradation::snapToEnd);
+                  float low { 0.f };
+                  float normal { 0.f };
+                  bool lowCanceled { false };
+
+                  auto lowAnimation { makeRamp (1, low, 10000) };
+                  lowAnimation->setPriority (AnimationType::Priority::low);
+                  lowAnimation->onCompletion ([&lowCanceled] (int, bool wasCanceled)
+                                              { lowCanceled = wasCanceled; });
+                  fAnimator->addAnimation (std::move (lowAnimation));
+                  fAnimator->addAnimation (makeRamp (2, normal, 10000));
+
+                  gotoTime (1000);
+                  gotoTime (1010);
+                  expectWithinAbsoluteError<float> (low, 100.f, 0.001f);
+                  expect (lowCanceled);
+                  expect (fAnimator->getAnimation (1) == nullptr);
+                  expectEquals (fAnimator->getBudgetStats ().animationsSnapped, 1);
+
+                  // normal priority is never snapped.
+                  for (juce::int64 time { 1020 }; time <= 1100; time += 10)
+                      gotoTime (time);
+                  expect (fAnimator->getAnimation (2) != nullptr);
+                  expect (normal < 100.f);
+              });
+    }
+
+private:
+    static constexpr double kTinyBudget { 1e-9 };
+
+    void addCounted (AnimationType::Priority priority, int& updateCount)
+    {
+        auto animation { makeAnimation<Linear> (0, 0.f, 1.f, 10000) };
+        animation->setPriority (priority);
+        animation->onUpdate ([&updateCount] (int, const Animation<1>::ValueList&)
+                             { ++updateCount; });
+        fAnimator->addAnimation (std::move (animation));
+    }
+};
+
+static Test_AnimatorBudget testAnimatorBudget;
+
+/**
+ * @brief Tests of animations bound to the component that they move.
+ */
+class Test_AnimatorBound : public AnimatorTest
+{
+public:
+    Test_AnimatorBound ()
+    : AnimatorTest ("Animator bound components")
+    {
+    }
+
+    void Setup () override
+    {
+        AnimatorTest::Setup ();
+        window.setBounds (0, 0, 200, 200);
+        window.addToDesktop (0);
+        window.setVisible (true);
+        child.setBounds (10, 10, 50, 50);
+        window.addAndMakeVisible (child);
+    }
+
+    void TearDown () override
+    {
+        AnimatorTest::TearDown ();
+        window.removeChildComponent (&child);
+        window.removeFromDesktop ();
+    }
+
+    void runTest () override
+    {
+        Test ("Skip updates while offscreen",
+              [=]
+              {
+                  float value { -1.f };
+                  int updateCount { 0 };
+                  auto animation { makeRamp (1, value) };
+                  animation->onUpdate (
+                      [&value, &updateCount] (int, const Animation<1>::ValueList& val)
+                      {
+                          value = val[0];
+                          ++updateCount;
+                      });
+                  animation->bindComponent (&child);
+                  expect (animation->isBound ());
+                  fAnimator->addAnimation (std::move (animation));
+
+                  child.setVisible (false);
+                  gotoTime (1000);
+                  gotoTime (1020);
+                  expectEquals (updateCount, 0);
+
+                  // back on screen, we pick up where the clock says we should be.
+                  child.setVisible (true);
+                  gotoTime (1040);
+                  expectEquals (updateCount, 1);
+                  expectWithinAbsoluteError<float> (value, 40.f, 0.001f);
+
+                  // scrolled out of its parent's bounds is offscreen too.
+                  child.setTopLeftPosition (300, 10);
+                  gotoTime (1060);
+                  expectEquals (updateCount, 1);
+                  child.setTopLeftPosition (10, 10);
+                  gotoTime (1080);
+                  expectEquals (updateCount, 2);
+                  expectWithinAbsoluteError<float> (value, 80.f, 0.001f);
+              });
+
+        Test ("Finish while offscreen",
+              [=]
+              {
+                  float value { -1.f };
+                  bool completed { false };
+                  bool canceled { true };
+                  auto animation { makeRamp (1, value) };
+                  animation->onCompletion (
+                      [&completed, &canceled] (int, bool wasCanceled)
+                      {
+                          completed = true;
+                          canceled  = wasCanceled;
+                      });
+                  animation->bindComponent (&child);
+                  fAnimator->addAnimation (std::move (animation));
+
+                  window.setVisible (false);
+                  gotoTime (1000);
+                  gotoTime (1050);
+                  expect (!completed);
+
+                  // the end value is still delivered once the time is up.
+                  gotoTime (1100);
+                  expectWithinAbsoluteError<float> (value, 100.f, 0.001f);
+                  expect (completed);
+                  expect (!canceled);
+                  expect (fAnimator->getAnimation (1) == nullptr);
+              });
+
+        Test ("Cancel when the component is deleted",
+              [=]
+              {
+                  auto target { std::make_unique<juce::Component> () };
+                  target->setBounds (10, 10, 50, 50);
+                  window.addAndMakeVisible (*target);
+
+                  float value { -1.f };
+                  bool canceled { false };
+                  auto animation { makeRamp (1, value) };
+                  animation->onCompletion ([&canceled] (int, bool wasCanceled)
+                                           { canceled = wasCanceled; });
+                  animation->bindComponent (target.get ());
+                  fAnimator->addAnimation (std::move (animation));
+
+                  gotoTime (1000);
+                  expect (fAnimator->getAnimation (1) != nullptr);
+                  const auto lastValue { value };
+
+                  target.reset ();
+                  gotoTime (1020);
+                  expect (canceled);
+                  expect (fAnimator->getAnimation (1) == nullptr);
+                  // and no update after the component is gone.
+                  expectEquals (value, lastValue);
+              });
+    }
+
+private:
+    juce::Component window;
+    juce::Component child;
+};
+
+static Test_AnimatorBound testAnimatorBound;
+
+/**
+ * @brief Tests of pausing and scaling the animator's clock.
+ */
+class Test_AnimatorClock : public AnimatorTest
+{
+public:
+    Test_AnimatorClock ()
+    : AnimatorTest ("Animator clock")
+    {
+    }
+
+    void runTest () override
+    {
+        Test ("Pause and resume",
+              [=]
+              {
+                  float value { 0.f };
+                  fAnimator->addAnimation (makeRamp (1, value));
+                  gotoTime (1000);
+                  gotoTime (1020);
+
+                  fAnimator->pause ();
+                  expect (fAnimator->isPaused ());
+                  expect (!fAnimator->getController ()->isRunning ());
+
+                  // continues from where it was, not counting the pause.
+                  fAnimator->resume ();
+                  expect (fAnimator->getController ()->isRunning ());
+                  gotoTime (5000);
+                  gotoTime (5010);
+                  expectWithinAbsoluteError<float> (value, 30.f, 0.001f);
+              });
+
+        Test ("Time scale",
+              [=]
+              {
+                  float value { 0.f };
+                  fAnimator->addAnimation (makeRamp (1, value));
+                  gotoTime (1000);
+                  fAnimator->setTimeScale (0.5f);
+                  gotoTime (1040);
+                  expectWithinAbsoluteError<float> (value, 20.f, 0.001f);
+                  fAnimator->setTimeScale (2.f);
+                  gotoTime (1050);
+                  expectWithinAbsoluteError<float> (value, 40.f, 0.001f);
+
+                  // sampling uses the same clock.
+                  std::array<float, 1> sampled;
+                  expect (fAnimator->sample (1, 1060, sampled));
+                  expectWithinAbsoluteError<float> (sampled[0], 60.f, 0.001f);
+              });
+
+        Test ("Adding while paused doesn't start the clock",
+              [=]
+              {
+                  float value { 0.f };
+                  fAnimator->pause ();
+                  fAnimator->addAnimation (makeRamp (1, value));
+                  expect (!fAnimator->getController ()->isRunning ());
+                  fAnimator->resume ();
+                  expect (fAnimator->getController ()->isRunning ());
+              });
+
+        Test ("Animations have clocks of their own",
+              [=]
+              {
+                  float scaled { 0.f };
+                  float paused { 0.f };
+                  fAnimator->addAnimation (makeRamp (1, scaled));
+                  fAnimator->addAnimation (makeRamp (2, paused));
+                  gotoTime (1000);
+                  fAnimator->getAnimation (1)->setTimeScale (0.5f);
+                  fAnimator->getAnimation (2)->setPaused (true);
+
+                  gotoTime (1040);
+                  expectWithinAbsoluteError<float> (scaled, 20.f, 0.001f);
+                  expectWithinAbsoluteError<float> (paused, 0.f, 0.001f);
+
+                  // continues from where it was paused.
+                  fAnimator->getAnimation (2)->setPaused (false);
+                  gotoTime (1060);
+                  expectWithinAbsoluteError<float> (scaled, 30.f, 0.001f);
+                  expectWithinAbsoluteError<float> (paused, 20.f, 0.001f);
+              });
+
+        Test ("Batched physics follow a re-scaled animation",
+              [=]
+              {
+                  // the same curve, stepped by the integrator and on its own.
+                  std::array<float, 2> values { 0.f, 0.f };
+                  for (size_t i { 0 }; i < values.size (); ++i)
+                  {
+                      fAnimator->setBatchedPhysics (i == 0);
+                      auto animation { makeAnimation<EaseIn> (static_cast<int> (i), 0.f,
+                                                              100.f, 0.01f, 0.05f) };
+                      animation->onUpdate (
+                          [&values, i] (int, const Animation<1>::ValueList& val)
+                          { values[i] = val[0]; });
+                      fAnimator->addAnimation (std::move (animation));
+                  }
+                  // re-scaled and then canceled before the next frame.
+                  fAnimator->setBatchedPhysics (true);
+                  fAnimator->addAnimation (makeAnimation<EaseIn> (2, 0.f, 1.f, 0.01f, 0.05f));
+
+                  gotoTime (1000);
+                  gotoTime (1010);
+                  for (int id : { 0, 1, 2 })
+                      fAnimator->getAnimation (id)->setTimeScale (0.5f);
+                  fAnimator->cancelAnimation (2, false);
+                  gotoTime (1020);
+                  fAnimator->getAnimation (0)->setPaused (true);
+                  fAnimator->getAnimation (1)->setPaused (true);
+                  gotoTime (1030);
+                  expectWithinAbsoluteError<float> (values[0], values[1], 0.0001f);
+                  fAnimator->getAnimation (0)->setPaused (false);
+                  fAnimator->getAnimation (1)->setPaused (false);
+                  gotoTime (1040);
+                  gotoTime (1050);
+                  expectWithinAbsoluteError<float> (values[0], values[1], 0.0001f);
+                  expect (values[0] > 0.f);
+              });
+    }
+};
+
+static Test_AnimatorClock testAnimatorClock;
+
+/**
+ * @brief Tests of operating on animations by tag.
+ */
+class Test_AnimatorTags : public AnimatorTest
+{
+public:
+    Test_AnimatorTags ()
+    : AnimatorTest ("Animator tags")
+    {
+    }
+
+    void runTest () override
+    {
+        Test ("Find by tag",
+              [=]
+              {
+                  addTagged (1, kPanel);
+                  addTagged (2, kPanel | kFades);
+                  addTagged (3, kFades);
+                  addTagged (4, 0);
+
+                  std::vector<AnimationType*> found;
+                  expectEquals (fAnimator->getTaggedAnimations (kPanel, found), 2);
+                  found.clear ();
+                  expectEquals (fAnimator->getTaggedAnimations (kFades, found), 2);
+                  // listed once, even with both tags.
+                  found.clear ();
+                  expectEquals (fAnimator->getTaggedAnimations (kPanel | kFades, found), 3);
+              });
+
+        Test ("Cancel by tag",
+              [=]
+              {
+                  for (int id { 0 }; id < 10; ++id)
+                      addTagged (id, (id % 2 == 0) ? kPanel : (kPanel | kFades));
+
+                  std::vector<AnimationType*> found;
+                  expectEquals (fAnimator->cancelTagged (kFades, false), 5);
+                  expectEquals (fAnimator->getTaggedAnimations (kFades, found), 0);
+                  expectEquals (fAnimator->getTaggedAnimations (kPanel, found), 5);
+                  for (auto* animation : found)
+                      expect (animation->getId () % 2 == 0);
+                  expect (fAnimator->getAnimation (1) == nullptr);
+                  expect (fAnimator->getAnimation (2) != nullptr);
+
+                  // removed from the index in any order, the rest stay findable.
+                  expectEquals (fAnimator->cancelTagged (kPanel, false), 5);
+                  found.clear ();
+                  expectEquals (fAnimator->getTaggedAnimations (kPanel, found), 0);
+                  gotoTime (1000);
+                  expect (!fAnimator->getController ()->isRunning ());
+              });
+
+        Test ("Cancel delayed animations by tag",
+              [=]
+              {
+                  bool isComplete { false };
+                  auto animation { makeAnimation<Linear> (1, 0.f, 100.f, 100) };
+                  animation->setTags (kPanel);
+                  animation->setDelay (5000);
+                  animation->onCompletion ([&isComplete] (int, bool wasCanceled)
+                                           { isComplete = wasCanceled; });
+                  fAnimator->addAnimation (std::move (animation));
+                  addTagged (2, kFades);
+                  fAnimator->getAnimation (2)->setDelay (3000);
+                  gotoTime (1000);
+
+                  // we don't wait for their delays to stop running.
+                  expectEquals (fAnimator->cancelTagged (kPanel | kFades, false), 2);
+                  gotoTime (1010);
+                  expect (isComplete);
+                  expect (!fAnimator->getController ()->isRunning ());
+              });
+
+        Test ("Pause, scale and retarget by tag",
+              [=]
+              {
+                  float paused { 0.f };
+                  float scaled { 0.f };
+                  float other { 0.f };
+                  addTagged (1, kPanel, &paused);
+                  addTagged (2, kFades, &scaled);
+                  addTagged (3, 0, &other);
+
+                  gotoTime (1000);
+                  expectEquals (fAnimator->pauseTagged (kPanel, true), 1);
+                  expectEquals (fAnimator->setTimeScaleTagged (kFades, 2.f), 1);
+                  gotoTime (1010);
+                  expectWithinAbsoluteError<float> (paused, 0.f, 0.001f);
+                  expectWithinAbsoluteError<float> (scaled, 20.f, 0.001f);
+                  expectWithinAbsoluteError<float> (other, 10.f, 0.001f);
+
+                  fAnimator->pauseTagged (kPanel, false);
+                  gotoTime (1020);
+                  expectWithinAbsoluteError<float> (paused, 10.f, 0.001f);
+
+                  expectEquals (fAnimator->updateTargetTagged (kPanel | kFades, 0, 0.f), 2);
+              });
+
+        Test ("Batched physics follow their animation's clock",
+              [=]
+              {
+                  // the same curve, stepped by the integrator and on its own.
+                  std::array<float, 2> values { 0.f, 0.f };
+                  for (size_t i { 0 }; i < values.size (); ++i)
+                  {
+                      fAnimator->setBatchedPhysics (i == 0);
+                      auto animation { makeAnimation<EaseIn> (static_cast<int> (i), 0.f,
+                                                              100.f, 0.01f, 0.05f) };
+                      animation->setTags (kPanel);
+                      animation->onUpdate (
+                          [&values, i] (int, const Animation<1>::ValueList& val)
+                          { values[i] = val[0]; });
+                      fAnimator->addAnimation (std::move (animation));
+                  }
+
+                  gotoTime (1000);
+                  gotoTime (1010);
+                  fAnimator->pauseTagged (kPanel, true);
+                  gotoTime (1020);
+                  gotoTime (1030);
+                  fAnimator->pauseTagged (kPanel, false);
+                  fAnimator->setTimeScaleTagged (kPanel, 0.5f);
+                  gotoTime (1040);
+                  gotoTime (1050);
+                  expectWithinAbsoluteError<float> (values[0], values[1], 0.0001f);
+              });
+    }
+
+private:
+    static constexpr juce::uint32 kPanel { 1u << 0 };
+    static constexpr juce::uint32 kFades { 1u << 5 };
+
+    void addTagged (int id, juce::uint32 tags, float* value = nullptr)
+    {
+        auto animation { makeAnimation<Linear> (id, 0.f, 100.f, 100) };
+        animation->setTags (tags);
+        if (value != nullptr)
+        {
+            animation->onUpdate ([value] (int, const Animation<1>::ValueList& val)
+                                 { *value = val[0]; });
+        }
+        fAnimator->addAnimation (std::move (animation));
+    }
+};
+
+static Test_AnimatorTags testAnimatorTags;
+
+/**
+ * @brief Tests of the completion sink, which receives each frame's
+ * completions in a single call.
+ */
+class Test_AnimatorCompletionSink : public AnimatorTest
+{
+public:
+    Test_AnimatorCompletionSink ()
+    : AnimatorTest ("Animator completion sink")
+    {
+    }
+
+    void Setup () override
+    {
+        AnimatorTest::Setup ();
+        batches.clear ();
+        fAnimator->setCompletionSink ([this] (const std::vector<Animator::Completion>& batch)
+                                      { batches.push_back (batch); });
+    }
+
+    void runTest () override
+    {
+        Test ("One batch per frame",
+              [=]
+              {
+                  float value { 0.f };
+                  for (int id { 0 }; id < 4; ++id)
+                      fAnimator->addAnimation (makeRamp (id, value, (id < 3) ? 50 : 100));
+
+                  gotoTime (1000);
+                  gotoTime (1025);
+                  expect (batches.empty ());
+                  gotoTime (1050);
+                  expectEquals (static_cast<int> (batches.size ()), 1);
+                  expect (!batches.empty () && batches[0].size () == 3);
+                  for (const auto& batch : batches)
+                  {
+                      for (const auto& completion : batch)
+                          expect (!completion.wasCanceled);
+                  }
+
+                  gotoTime (1100);
+                  expectEquals (static_cast<int> (batches.size ()), 2);
+                  expect (batches.size () == 2 && batches[1][0].id == 3);
+              });
+
+        Test ("Cancels are sent with the next frame",
+              [=]
+              {
+                  float value { 0.f };
+                  for (int id { 0 }; id < 3; ++id)
+                      fAnimator->addAnimation (makeRamp (id, value));
+                  gotoTime (1000);
+
+                  fAnimator->cancelAnimation (0, false);
+                  fAnimator->cancelAnimation (1, false);
+                  expect (batches.empty ());
+
+                  gotoTime (1010);
+                  expectEquals (static_cast<int> (batches.size ()), 1);
+                  expectEquals (static_cast<int> (batches[0].size ()), 2);
+                  for (const auto& completion : batches[0])
+                      expect (completion.wasCanceled);
+
+                  // canceling the last one keeps us running until it's sent.
+                  fAnimator->cancelAnimation (2, false);
+                  expect (fAnimator->getController ()->isRunning ());
+                  gotoTime (1020);
+                  expectEquals (static_cast<int> (batches.size ()), 2);
+                  expect (!fAnimator->getController ()->isRunning ());
+              });
+
+        Test ("Completion in the frame that reaches the end",
+              [=]
+              {
+                  // `second` reaches its end value in the frame after `first` does.
+                  // If each only reported finishing on its following update,
+                  // cleaning up `first` would also remove `second` before its
+                  // completion was ever sent.
+                  float value { 0.f };
+                  std::array<int, 2> completedAt { -1, -1 };
+                  for (int id { 0 }; id < 2; ++id)
+                  {
+                      auto animation { makeRamp (id, value, 100 + 10 * id) };
+                      animation->onCompletion ([&completedAt, this] (int id, bool)
+                                               { completedAt[id] = frame; });
+                      fAnimator->addAnimation (std::move (animation));
+                  }
+
+                  const juce::int64 times[] { 1000, 1100, 1110, 1120 };
+                  for (frame = 0; frame < 4; ++frame)
+                      gotoTime (times[frame]);
+
+                  expectEquals (completedAt[0], 1);
+                  expectEquals (completedAt[1], 2);
+                  expectEquals (static_cast<int> (batches.size ()), 2);
+                  expect (batches.size () == 2 && batches[1][0].id == 1);
+              });
+    }
+
+private:
+    std::vector<std::vector<Animator::Completion>> batches;
+    int frame { 0 };
+};
+
+static Test_AnimatorCompletionSink testAnimatorCompletionSink;
+
+/**
+ * @brief Tests of the frame begin/end callbacks, and of coalescing repaints
+ * until the end of each frame.
+ */
+class Test_AnimatorFrameHooks : public AnimatorTest
+{
+public:
+    Test_AnimatorFrameHooks ()
+    : AnimatorTest ("Animator frame hooks")
+    {
+    }
+
+    void runTest () override
+    {
+        Test ("Hooks surround the updates",
+              [=]
+              {
+                  std::vector<juce::int64> events;
+                  fAnimator->onFrameBegin ([&events] (juce::int64 time)
+                                           { events.push_back (time); });
+                  fAnimator->onFrameEnd ([&events] (juce::int64 time)
+                                         { events.push_back (-time); });
+                  auto animation { makeAnimation<Linear> (1, 0.f, 1.f, 100) };
+                  animation->onUpdate ([&events] (int, const Animation<1>::ValueList&)
+                                       { events.push_back (0); });
+                  fAnimator->addAnimation (std::move (animation));
+
+                  gotoTime (1000);
+                  gotoTime (1010);
+                  const std::vector<juce::int64> expected { 1000, 0, -1000, 1010, 0, -1010 };
+                  expect (events == expected);
+              });
+
+        Test ("Repaints wait for the end of the frame",
+              [=]
+              {
+                  juce::Component host;
+                  RepaintCoalescer coalescer { host };
+                  coalescer.attach (*fAnimator);
+
+                  int dirtyUpdates { 0 };
+                  for (int id { 0 }; id < 3; ++id)
+                  {
+                      auto animation { makeAnimation<Linear> (id, 0.f, 1.f, 100) };
+                      animation->onUpdate (
+                          [&coalescer, &dirtyUpdates] (int, const Animation<1>::ValueList&)
+                          {
+                              coalescer.markDirty ({ 0, 0, 10, 10 });
+                              dirtyUpdates += coalescer.isDirty () ? 1 : 0;
+                          });
+                      fAnimator->addAnimation (std::move (animation));
+                  }
+
+                  gotoTime (1000);
+                  expectEquals (dirtyUpdates, 3);
+                  expect (!coalescer.isDirty ());
+
+                  coalescer.markDirty ({ 5, 5, 10, 10 });
+                  expect (coalescer.isDirty ());
+                  coalescer.flush ();
+                  expect (!coalescer.isDirty ());
+                  fAnimator->onFrameEnd (nullptr);
+              });
+
+        Test ("Dirty areas aren't merged",
+              [=]
+              {
+                  juce::Component host;
+                  host.setBounds (0, 0, 500, 500);
+                  juce::Component child;
+                  child.setBounds (400, 400, 20, 20);
+                  host.addAndMakeVisible (child);
+                  RepaintCoalescer coalescer { host };
+
+                  coalescer.markDirty ({ 0, 0, 10, 10 });
+                  coalescer.markDirty (child);
+                  coalescer.markDirty (child, { 0, 0, 0, 0 });
+
+                  // two far-apart areas stay separate (and in host coordinates)
+                  // instead of growing to the bounds of both.
+                  const auto& areas { coalescer.getDirtyAreas () };
+                  expectEquals (areas.getNumRectangles (), 2);
+                  expect (areas.getBounds () == juce::Rectangle<int> (0, 0, 420, 420));
+                  expect (!areas.intersectsRectangle ({ 100, 100, 10, 10 }));
+
+                  coalescer.flush ();
+                  expect (!coalescer.isDirty ());
+                  host.removeChildComponent (&child);
+              });
+    }
+};
+
+static Test_AnimatorFrameHooks testAnimatorFrameHooks;
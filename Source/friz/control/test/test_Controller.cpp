@@ -0,0 +1,76 @@
+class Test_PresentationClock : public SubTest
+{
+public:
+    Test_PresentationClock ()
+    : SubTest ("PresentationClock", "Controller")
+    {
+    }
+
+    void runTest () override
+    {
+        Test ("Prediction off",
+              [=]
+              {
+                  PresentationClock clock;
+                  expect (!clock.isPredicting ());
+                  expectEquals<juce::int64> (clock.getFrameTime (), -1);
+
+                  // frames are evaluated at the time of the callback; the
+                  // latency offset is ignored.
+                  clock.setPrediction (false, 5);
+                  expectEquals<juce::int64> (clock.update (100, 60.f), 100);
+                  expectEquals<juce::int64> (clock.update (117, 60.f), 117);
+                  expectEquals<juce::int64> (clock.getFrameTime (), 117);
+              });
+
+        Test ("Prediction on",
+              [=]
+              {
+                  PresentationClock clock;
+                  clock.setPrediction (true);
+                  expect (clock.isPredicting ());
+
+                  // until we know the refresh rate, there's nothing to add.
+                  expectEquals<juce::int64> (clock.update (100, 0.f), 100);
+                  // one refresh interval ahead (16.67 ms rounds to 17)
+                  expectEquals<juce::int64> (clock.update (117, 60.f), 134);
+                  expectEquals<juce::int64> (clock.update (200, 30.f), 233);
+
+                  // plus the latency offset, which may be negative.
+                  clock.setPrediction (true, 4);
+                  expectEquals<juce::int64> (clock.update (300, 60.f), 321);
+                  clock.setPrediction (true, -10);
+                  expectEquals<juce::int64> (clock.update (400, 60.f), 407);
+              });
+
+        Test ("Time never goes backward",
+              [=]
+              {
+                  PresentationClock clock;
+                  clock.setPrediction (true);
+
+                  // a refresh interval that wobbles from frame to frame.
+                  const float rates[] { 60.f, 50.f, 120.f, 61.f, 240.f, 45.f, 59.f };
+                  juce::int64 now { 1000 };
+                  juce::int64 previous { -1 };
+                  for (const auto rate : rates)
+                  {
+                      const auto frameTime { clock.update (now, rate) };
+                      expect (frameTime >= previous);
+                      expect (frameTime >= now);
+                      previous = frameTime;
+                      now += 10;
+                  }
+
+                  // turning prediction off can't jump us back to the callback time.
+                  clock.setPrediction (false);
+                  expectEquals<juce::int64> (clock.update (now, 60.f), previous);
+
+                  // but starting again forgets the previous frame.
+                  clock.reset ();
+                  expectEquals<juce::int64> (clock.update (now, 60.f), now);
+              });
+    }
+};
+
+static Test_PresentationClock testPresentationClock;
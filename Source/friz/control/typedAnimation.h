@@ -0,0 +1,243 @@
+/*
+    Copyright (c) 2019-2023 Brett g Porter
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#pragma once
+
+#include "../curves/valueTraits.h"
+#include "../curves/vecValue.h"
+#include "animation.h"
+
+namespace friz
+{
+
+/**
+ * @class TypedAnimation
+ *
+ * @brief An animation of a single value of some type (`juce::Point<float>`,
+ * `juce::Rectangle<float>`, `juce::Colour`, `juce::AffineTransform`...) that is
+ * passed directly to its update callback, with no unpacking needed.
+ *
+ * Instead of one `AnimatedValue` object per component of the value, all of
+ * the components are stored together in a single `VecValue` and share one
+ * evaluation of the easing curve on each frame.
+ *
+ * @tparam T      Type of value to animate.
+ * @tparam Traits describes how to convert between T and its lanes.
+ */
+template <typename T, typename Traits = ValueTraits<T>>
+class TypedAnimation : public AnimationType
+{
+public:
+    using ValueType = VecValue<Traits::laneCount>;
+    using UpdateFn  = std::function<void (int, const T&)>;
+
+    /**
+     * @brief Construct a new TypedAnimation.
+     *
+     * @param from      starting value
+     * @param to        ending value
+     * @param duration  in ms
+     * @param type      easing curve used to move between the values.
+     * @param id        animation ID.
+     */
+    TypedAnimation (const T& from, const T& to, int duration,
+                    Parametric::CurveType type = Parametric::kLinear, int id = 0)
+    : AnimationType { id }
+    , value { makeValue (from, to, duration, type) }
+    {
+    }
+
+    /**
+     * Set the function that will be called with the current value once per
+     * frame. `updateFn` is public, so you can also just assign to it directly.
+     * @param update UpdateFn function.
+     */
+    void onUpdate (UpdateFn update) { updateFn = update; }
+
+    Status gotoTime (juce::int64 timeInMs) override
+    {
+        if (finished)
+        {
+            notifyCompletion (false);
+            return Status::finished;
+        }
+
+        juce::int64 effectElapsed;
+        juce::int64 deltaTime;
+        if (!advanceClock (timeInMs, effectElapsed, deltaTime))
+            return Status::processing;
+
+        const auto& lanes { value.getNextValue (static_cast<int> (effectElapsed)) };
+
+        if (updateFn != nullptr)
+            updateFn (getId (), Traits::fromLanes (lanes));
+
+        if (value.isFinished ())
+            finished = true;
+
+        return Status::processing;
+    }
+
+    void cancel (bool moveToEndPosition) override
+    {
+        value.cancel (moveToEndPosition);
+
+        if (moveToEndPosition && updateFn != nullptr)
+            updateFn (getId (), Traits::fromLanes (value.getEndValue ()));
+
+        notifyCompletion (true);
+        finished = true;
+    }
+
+    bool isFinished () override { return finished; }
+
+    bool isReady () const override { return true; }
+
+    /**
+     * @brief Our lanes aren't separate `AnimatedValue` objects, so there's
+     * nothing to return here; use `updateTarget()` to change where we're going.
+     */
+    AnimatedValue* getValue (size_t /*index*/) override { return nullptr; }
+
+    /**
+     * @brief Change the end value of one of our lanes, in the representation
+     * used by our traits (e.g. for a rectangle, 0..3 are x, y, width and
+     * height). This is what `Animator::updateTarget()` calls.
+     *
+     * @sa VecValue::updateTarget
+     */
+    bool updateTarget (size_t index, float newTarget) override
+    {
+        return value.updateTarget (index, newTarget);
+    }
+
+    /**
+     * @brief Head toward a new end value from wherever we are now, still
+     * finishing on time.
+     *
+     * @param newTarget
+     * @return false if we've already finished.
+     */
+    bool updateTarget (const T& newTarget)
+    {
+        // e.g. go the short way around to the new hue or angle from here.
+        auto current { value.getCurrentValue () };
+        auto lanes { Traits::toLanes (newTarget) };
+        prepareLanes<Traits> (current, lanes);
+        return value.updateTarget (lanes);
+    }
+
+    /**
+     * @brief Calculate our value at a point in time without changing any state.
+     *
+     * @param timeInMs Time on the same clock that's used to call `gotoTime()`
+     * @param result
+     */
+    void valueAt (juce::int64 timeInMs, T& result) const
+    {
+        typename ValueType::Lanes lanes;
+        value.valueAt (static_cast<int> (getEffectElapsed (timeInMs)), lanes);
+        result = Traits::fromLanes (lanes);
+    }
+
+    bool sample (juce::int64 timeInMs, float* values, size_t valueCount) override
+    {
+        if (valueCount < Traits::laneCount)
+        {
+            jassertfalse;
+            return false;
+        }
+
+        typename ValueType::Lanes lanes;
+        value.valueAt (static_cast<int> (getEffectElapsed (timeInMs)), lanes);
+        std::copy (lanes.begin (), lanes.end (), values);
+        return true;
+    }
+
+    Status seek (juce::int64 timeInMs) override
+    {
+        if (startTime < 0)
+            setStartTime (timeInMs);
+        lastTime = timeInMs;
+
+        const auto& lanes { value.seek (static_cast<int> (getEffectElapsed (timeInMs))) };
+
+        if (updateFn != nullptr)
+            updateFn (getId (), Traits::fromLanes (lanes));
+
+        if (value.isFinished () && !finished)
+            notifyCompletion (false);
+        finished = value.isFinished ();
+
+        return finished ? Status::finished : Status::processing;
+    }
+
+    juce::int64 getDuration () const override { return preDelay + value.getDuration (); }
+
+    /**
+     * @return the multi-lane value object driving this animation.
+     */
+    ValueType& getVecValue () { return value; }
+
+public:
+    /// function to call on each frame with the current value.
+    UpdateFn updateFn;
+
+private:
+    static ValueType makeValue (const T& from, const T& to, int duration,
+                                Parametric::CurveType type)
+    {
+        auto fromLanes { Traits::toLanes (from) };
+        auto toLanes { Traits::toLanes (to) };
+        prepareLanes<Traits> (fromLanes, toLanes);
+        return { fromLanes, toLanes, duration, Parametric::getEasingFunction (type) };
+    }
+
+private:
+    ValueType value;
+
+    /// is this animation complete?
+    bool finished { false };
+};
+
+/**
+ * @brief Factory function to create a typed animation.
+ *
+ * @tparam T type of value to animate; must have a `ValueTraits` specialization.
+ * @tparam Traits conversion to and from lanes, e.g. `OklabColourTraits` to
+ *         animate a `juce::Colour` in the OKLab colour space.
+ * @param id Animation ID
+ * @param from starting value
+ * @param to ending value
+ * @param duration in ms
+ * @param type easing curve to use.
+ * @return std::unique_ptr<TypedAnimation<T>>
+ */
+template <typename T, typename Traits = ValueTraits<T>>
+std::unique_ptr<TypedAnimation<T, Traits>>
+makeTypedAnimation (int id, const T& from, const T& to, int duration,
+                    Parametric::CurveType type = Parametric::kLinear)
+{
+    return std::make_unique<TypedAnimation<T, Traits>> (from, to, duration, type, id);
+}
+
+} // namespace friz
@@ -21,3 +21,176 @@
 */
 
 #include "animatedValue.h"
+
+namespace friz
+{
+
+bool ToleranceValue::attachIntegrator (FixedStepIntegrator& newIntegrator)
+{
+    FixedStepIntegrator::State state;
+    if (integrator != nullptr || !getIntegratorState (state))
+        return false;
+
+    state.value      = currentVal;
+    state.target     = endVal;
+    state.tolerance  = tolerance;
+    state.finished   = isFinished ();
+    integratorHandle = newIntegrator.add (state);
+    integrator       = &newIntegrator;
+    return true;
+}
+
+float ToleranceValue::seek (int msElapsed)
+{
+    // seeking needs to be able to step ourselves.
+    jassert (integrator == nullptr);
+    detachIntegrator ();
+
+    msElapsed = std::max (0, msElapsed);
+
+    if (msElapsed < stepCount)
+    {
+        // find the last checkpoint at or before the requested time.
+        auto it { std::upper_bound (checkpoints.begin (), checkpoints.end (), msElapsed,
+                                    [] (int time, const Checkpoint& checkpoint)
+                                    { return time < checkpoint.time; }) };
+        if (it == checkpoints.begin ())
+        {
+            // no checkpoint to go back to; see setCheckpointInterval()
+            jassertfalse;
+            return currentVal;
+        }
+
+        --it;
+        restoreState (it->state);
+        stepCount = it->time;
+    }
+
+    step (msElapsed - stepCount);
+    return currentVal;
+}
+
+void ToleranceValue::step (int steps)
+{
+    for (int i { 0 }; i < steps; ++i)
+    {
+        if (isFinished ())
+            break;
+
+        if (checkpointInterval > 0 && stepCount % checkpointInterval == 0 &&
+            (checkpoints.empty () || checkpoints.back ().time < stepCount))
+        {
+            checkpoints.push_back ({ stepCount, captureState () });
+        }
+
+        currentVal = snapToEnd (generateNextValue ());
+        ++stepCount;
+    }
+}
+
+FixedStepIntegrator::State ToleranceValue::captureState () const
+{
+    FixedStepIntegrator::State state;
+    getIntegratorState (state);
+    state.value     = currentVal;
+    state.target    = endVal;
+    state.tolerance = tolerance;
+    state.finished  = finished;
+    return state;
+}
+
+void ToleranceValue::restoreState (const FixedStepIntegrator::State& state)
+{
+    currentVal = state.value;
+    endVal     = state.target;
+    finished   = state.finished;
+    setIntegratorState (state);
+}
+
+void ToleranceValue::detachIntegrator ()
+{
+    if (integrator == nullptr)
+        return;
+
+    const auto state { integrator->getState (integratorHandle) };
+    currentVal = state.value;
+    finished   = state.finished;
+    setIntegratorState (state);
+
+    integrator->release (integratorHandle);
+    integrator       = nullptr;
+    integratorHandle = -1;
+}
+
+bool TimedValue::updateTarget (float newTarget)
+{
+    const auto remaining { duration - lastElapsed };
+    if (finished || canceled || remaining <= 0)
+        return false;
+
+    // position & velocity (per ms) along the path we're on now...
+    const auto now { lastElapsed };
+    const auto before { std::max (0, now - 1) };
+    const auto span { static_cast<float> (now + 1 - before) };
+    const auto position { valueAt (now) };
+    const auto velocity { (valueAt (now + 1) - valueAt (before)) / span };
+
+    // ...and along the un-blended curve to the new target.
+    endVal      = newTarget;
+    blendLength = 0.f;
+    const auto newPosition { valueAt (now) };
+    const auto newVelocity { (valueAt (now + 1) - valueAt (before)) / span };
+
+    blendStart    = static_cast<float> (now);
+    blendLength   = static_cast<float> (remaining);
+    blendPosition = position - newPosition;
+    blendVelocity = (velocity - newVelocity) * blendLength;
+    return true;
+}
+
+int TimedValue::renderBlock (float* dest, int numSamples, double sampleRate)
+{
+    jassert (sampleRate > 0.0);
+    jassert (dest != nullptr || numSamples == 0);
+
+    const auto durationInSamples { duration * sampleRate / 1000.0 };
+    const auto samplesLeft { std::max (
+        0.0, std::ceil (durationInSamples - blockPosition)) };
+    const auto rampCount { static_cast<int> (
+        std::min (static_cast<double> (numSamples), samplesLeft)) };
+
+    // write a linear progress ramp into the buffer, then let the curve
+    // transform it in place -- no scratch memory needed.
+    const auto step { static_cast<float> (1.0 / durationInSamples) };
+    const auto first { static_cast<float> (blockPosition / durationInSamples) };
+    for (int i { 0 }; i < rampCount; ++i)
+        dest[i] = first + static_cast<float> (i) * step;
+
+    generateBlock (dest, rampCount);
+
+    if (blendLength > 0.f)
+    {
+        const auto msPerSample { static_cast<float> (1000.0 / sampleRate) };
+        const auto firstMs { static_cast<float> (blockPosition * 1000.0 / sampleRate) };
+        for (int i { 0 }; i < rampCount; ++i)
+            dest[i] += getBlendOffset (firstMs + static_cast<float> (i) * msPerSample);
+    }
+
+    std::fill (dest + rampCount, dest + numSamples, endVal);
+
+    blockPosition += numSamples;
+    lastElapsed = static_cast<int> (blockPosition * 1000.0 / sampleRate);
+    if (rampCount < numSamples)
+        finished = true;
+
+    if (numSamples > 0)
+        currentVal = dest[numSamples - 1];
+
+    return rampCount;
+}
+
+#ifdef qRunUnitTests
+#include "test/test_AnimatedValue.cpp"
+#endif
+
+} // namespace friz
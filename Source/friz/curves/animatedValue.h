@@ -21,6 +21,8 @@
 */
 #pragma once
 
+#include "integrator.h"
+
 namespace friz
 {
 
@@ -58,12 +60,63 @@ public:
      */
     virtual float getNextValue (int msElapsed, int msSinceLastUpdate) = 0;
 
+    /**
+     * @brief Can this value be evaluated at an arbitrary point in time
+     * with `valueAt()`? True for the time-based curves, whose value depends
+     * only on the elapsed time; false for curves that are calculated
+     * incrementally from their previous state.
+     */
+    virtual bool canSample () const { return false; }
+
+    /**
+     * @brief Calculate the value at a point in time without changing the
+     * state of this object. Only valid if `canSample()` returns true.
+     *
+     * @param msElapsed time since this value started running.
+     * @return the value at that point in time.
+     */
+    virtual float valueAt (int /*msElapsed*/)
+    {
+        jassertfalse;
+        return currentVal;
+    }
+
+    /**
+     * @return Duration of this value in milliseconds, or -1 if it's not
+     * known in advance (e.g. for values that run until they're within a
+     * tolerance of their end value.)
+     */
+    virtual int getDuration () const { return -1; }
+
+    /**
+     * @brief Jump directly to a point in time, forward or backward, updating
+     * our state to match. Used to scrub through animations on a timeline.
+     *
+     * @param msElapsed time since this value started running.
+     * @return the value at that point in time.
+     */
+    virtual float seek (int /*msElapsed*/)
+    {
+        jassertfalse;
+        return currentVal;
+    }
+
+    /**
+     * @brief Keep track of the elapsed time without calculating a value. An
+     * animation whose values are pulled with `valueAt()` calls this each frame
+     * instead of `getNextValue()`, so anything that depends on our current
+     * position (e.g. `updateTarget()`) still knows where we are.
+     *
+     * @param msElapsed time since this value started running.
+     */
+    virtual void setElapsed (int /*msElapsed*/) {}
+
     /**
      * @brief get the ending state of this value object. When we cancel
      * an in-progress animation, we may need to snap to the end value, and
      * this gives a way to get there immediately.
      *
-     * @return float
+     * @return the value at that point in time.
      */
     float getEndValue () const { return endVal; }
 
@@ -126,6 +179,12 @@ public:
     {
     }
 
+    ~ToleranceValue () override
+    {
+        if (integrator != nullptr)
+            integrator->release (integratorHandle);
+    }
+
     /**
      * @brief Calculate the next value in the sequence based on the delta
      * time since last updated. Internally, we use an update rate of
@@ -137,19 +196,42 @@ public:
     float getNextValue (int /*msElapsed*/, int msSinceLastUpdate) override
     {
         jassert (msSinceLastUpdate >= 0);
-        if (msSinceLastUpdate == 0)
-            return currentVal;
 
-        for (int i { 0 }; i < msSinceLastUpdate; ++i)
+        if (integrator != nullptr)
         {
-            currentVal = snapToEnd (generateNextValue ());
-            if (isFinished ())
-                break;
+            // We're being stepped along with all the other physics values
+            // in the animator; the first time through, catch up on our own.
+            integrator->start (integratorHandle, msSinceLastUpdate);
+            currentVal = integrator->getValue (integratorHandle);
+            finished   = integrator->isFinished (integratorHandle);
+            return currentVal;
         }
 
+        step (msSinceLastUpdate);
         return currentVal;
     }
 
+    /**
+     * @brief Move to a point in time. Moving forward steps the value as usual;
+     * moving backward restores the nearest checkpoint before that time and
+     * steps forward from there, so checkpointing must be enabled first with
+     * `setCheckpointInterval()`.
+     *
+     * @param msElapsed time since this value started running.
+     * @return the value at that point in time.
+     */
+    float seek (int msElapsed) override;
+
+    /**
+     * @brief Save a snapshot of our state every `intervalMs` milliseconds of
+     * (simulated) time as we step, so that we can seek backward without replaying
+     * from the beginning. Call this before the value starts running. Values that
+     * don't describe their state with `getIntegratorState()` can only seek forward.
+     *
+     * @param intervalMs checkpoint spacing; <= 0 disables checkpointing.
+     */
+    void setCheckpointInterval (int intervalMs) { checkpointInterval = intervalMs; }
+
     /**
      * @brief Test to see if this value has reached its end state.
      */
@@ -161,7 +243,98 @@ public:
         return (finished || canceled);
     }
 
+    /**
+     * @brief Head toward a new end value from wherever we are now. Our state
+     * (including any velocity) carries over, so the value doesn't jump.
+     *
+     * As `SmoothedValue` always has, this accepts the new target even if we've
+     * already finished; it just won't move us.
+     *
+     * @param newTarget
+     * @return true
+     */
+    bool updateTarget (float newTarget) override
+    {
+        endVal = newTarget;
+        if (!(finished || canceled))
+        {
+            targetChanged ();
+            updateIntegratorTarget ();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Hand our calculations over to an integrator that steps many
+     * values together. The integrator must outlive this object.
+     *
+     * @param newIntegrator
+     * @return true if this kind of value supports batched integration.
+     */
+    bool attachIntegrator (FixedStepIntegrator& newIntegrator);
+
+    /**
+     * @brief Take our state back from the integrator (if we're attached to one)
+     * and go back to stepping ourselves.
+     */
+    void detachIntegrator ();
+
+protected:
+    /**
+     * @brief Describe the model and parameters that an integrator should use
+     * to step this value; the base class fills in the value, target and tolerance.
+     * This is also how checkpoints for seeking capture our state.
+     *
+     * @param state
+     * @return false if this kind of value can't be stepped by an integrator.
+     */
+    virtual bool getIntegratorState (FixedStepIntegrator::State& /*state*/) const
+    {
+        return false;
+    }
+
+    /**
+     * @brief Take back any model-specific state when detaching from an integrator
+     * or restoring a checkpoint.
+     */
+    virtual void setIntegratorState (const FixedStepIntegrator::State& /*state*/) {}
+
+    /**
+     * @brief Called by `updateTarget()` after `endVal` changes, for derived
+     * classes whose state depends on the direction of travel.
+     */
+    virtual void targetChanged () {}
+
+    /**
+     * @brief Pass a change to `endVal` along to the integrator, if we're
+     * attached to one.
+     */
+    void updateIntegratorTarget ()
+    {
+        if (integrator != nullptr)
+            integrator->setTarget (integratorHandle, endVal);
+    }
+
 private:
+    /**
+     * @brief Execute `steps` iterations of our curve function (one per ms),
+     * recording checkpoints along the way if enabled.
+     */
+    void step (int steps);
+
+    FixedStepIntegrator::State captureState () const;
+
+    void restoreState (const FixedStepIntegrator::State& state);
+
+    void doCancel (bool moveToEndPosition) override
+    {
+        if (moveToEndPosition)
+            currentVal = endVal;
+
+        if (integrator != nullptr)
+            integrator->finish (integratorHandle, moveToEndPosition);
+    }
+
     /**
      * @brief The underlying calculation (in floating point) may approach the
      * desired end value asymptotically; we've already defined a tolerance
@@ -188,6 +361,27 @@ private:
 
 protected:
     float tolerance;
+
+private:
+    /// @brief if non-null, steps our state for us.
+    FixedStepIntegrator* integrator { nullptr };
+    /// @brief our handle in the integrator.
+    int integratorHandle { -1 };
+
+    /// @brief number of 1 ms steps we've taken.
+    int stepCount { 0 };
+
+    struct Checkpoint
+    {
+        int time;
+        FixedStepIntegrator::State state;
+    };
+
+    /// @brief saved states, in order of time.
+    std::vector<Checkpoint> checkpoints;
+
+    /// @brief ms between checkpoints, or <= 0 if disabled.
+    int checkpointInterval { 0 };
 };
 
 class TimedValue : public AnimatedValue
@@ -202,27 +396,112 @@ public:
     float getNextValue (int msElapsed, int /* msSinceLastUpdate*/) override
     {
         if (msElapsed >= duration)
-        {
-            finished   = true;
-            currentVal = endVal;
-            return currentVal;
-        }
-        float progress { static_cast<float> (msElapsed) / duration };
-        return generateNextValue (progress);
+            finished = true;
+
+        lastElapsed = msElapsed;
+        currentVal  = valueAt (msElapsed);
+        return currentVal;
     }
 
     bool isFinished () override { return finished; }
 
+    bool canSample () const override { return true; }
+
+    float valueAt (int msElapsed) override
+    {
+        if (msElapsed >= duration)
+            return endVal;
+
+        float progress { static_cast<float> (std::max (0, msElapsed)) / duration };
+        return generateNextValue (progress) + getBlendOffset (static_cast<float> (msElapsed));
+    }
+
+    int getDuration () const override { return duration; }
+
+    /**
+     * @brief Time-based values can go directly to any point in time.
+     */
+    float seek (int msElapsed) override
+    {
+        finished    = msElapsed >= duration;
+        lastElapsed = msElapsed;
+        currentVal  = valueAt (msElapsed);
+        return currentVal;
+    }
+
+    void setElapsed (int msElapsed) override
+    {
+        finished    = msElapsed >= duration;
+        lastElapsed = msElapsed;
+    }
+
+    /**
+     * @brief Change the end value while we're running, without a jump in
+     * either position or velocity. The curve is re-scaled to head for the new
+     * end value, and the difference between where we are and where the new
+     * curve would put us (and between the two velocities) is faded out with a
+     * cubic Hermite blend over the rest of our duration, so we still arrive
+     * at the new target on time.
+     *
+     * @param newTarget
+     * @return false if we've already finished.
+     */
+    bool updateTarget (float newTarget) override;
+
+    /**
+     * @brief Render this value at audio rate, one value per sample, for use as a
+     * sample-accurate parameter ramp. Each call continues from where the previous
+     * one stopped; once the end of the duration is reached the rest of the block
+     * is filled with the end value.
+     *
+     * This doesn't allocate or lock, so it's safe to call from an audio
+     * callback. It's independent of the frame-based `getNextValue()`, so a
+     * value should be driven by one or the other.
+     *
+     * @param dest          buffer to fill with `numSamples` values
+     * @param numSamples    number of samples to render
+     * @param sampleRate    sample rate in Hz
+     * @return int number of samples that were still ramping; if this is less than
+     *         `numSamples`, the value has finished.
+     */
+    int renderBlock (float* dest, int numSamples, double sampleRate);
+
+    /**
+     * @brief Restart block rendering at the beginning of the curve.
+     */
+    void resetBlockPosition ()
+    {
+        blockPosition = 0.0;
+        finished      = false;
+    }
+
 protected:
     /**
      * @brief Given a fractional curve point (typically) in the range (0.f..1.f),
      * interpolate this point between this value's start and end points.
      *
      * @param curvePoint
-     * @return float
+     * @return the value at that point in time.
      */
     float scale (float curvePoint) { return startVal + curvePoint * (endVal - startVal); }
 
+    /**
+     * @brief Derived classes that override `valueAt()` should add this to the
+     * value of their curve so that `updateTarget()` stays continuous.
+     *
+     * @param msElapsed
+     * @return offset from the curve, or 0 if the target was never updated.
+     */
+    float getBlendOffset (float msElapsed) const
+    {
+        if (blendLength <= 0.f)
+            return 0.f;
+
+        const auto s { juce::jlimit (0.f, 1.f, (msElapsed - blendStart) / blendLength) };
+        const auto rest { 1.f - s };
+        return rest * rest * (blendPosition * (1.f + 2.f * s) + blendVelocity * s);
+    }
+
 private:
     /**
      * @brief generate the value according to progress in time.
@@ -232,9 +511,39 @@ private:
      */
     virtual float generateNextValue (float progress) = 0;
 
+    /**
+     * @brief Convert a block of progress values (0.0..1.0) into curve values
+     * in place. The default calls `generateNextValue()` for each sample; derived
+     * classes can override this with something that's cheaper to run in bulk.
+     *
+     * @param values    progress values in, curve values out.
+     * @param numValues
+     */
+    virtual void generateBlock (float* values, int numValues)
+    {
+        for (int i { 0 }; i < numValues; ++i)
+            values[i] = generateNextValue (values[i]);
+    }
+
 protected:
     /// @brief duration of the event in ms.
     int duration;
+
+private:
+    /// @brief position (in samples) of the next sample to render with `renderBlock()`
+    double blockPosition { 0.0 };
+
+    /// @brief time of the most recent value we generated, in ms.
+    int lastElapsed { 0 };
+
+    /// @brief time (ms) when the target was last updated.
+    float blendStart { 0.f };
+    /// @brief length (ms) of the blend into the new curve; 0 if not blending.
+    float blendLength { 0.f };
+    /// @brief position difference to fade out over the blend.
+    float blendPosition { 0.f };
+    /// @brief velocity difference to fade out, scaled by `blendLength`.
+    float blendVelocity { 0.f };
 };
 
 // GCC doesn't support some functions that are specified in the standard:
@@ -0,0 +1,209 @@
+/*
+    Copyright (c) 2019-2023 Brett g Porter
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "colourTraits.h"
+
+namespace
+{
+/// @brief below this chroma, a colour is treated as grey.
+constexpr float kMinChroma { 0.0001f };
+
+/**
+ * @return components divided by alpha (or zero if transparent)
+ */
+float unpremultiply (float c, float alpha)
+{
+    return (alpha > 0.f) ? c / alpha : 0.f;
+}
+} // namespace
+
+namespace friz
+{
+namespace colour
+{
+float srgbToLinear (float c)
+{
+    return (c <= 0.04045f) ? c / 12.92f : std::pow ((c + 0.055f) / 1.055f, 2.4f);
+}
+
+float linearToSrgb (float c)
+{
+    c = std::max (0.f, c);
+    return (c <= 0.0031308f) ? c * 12.92f : 1.055f * std::pow (c, 1.f / 2.4f) - 0.055f;
+}
+
+std::array<float, 3> linearToOklab (float r, float g, float b)
+{
+    const auto l { std::cbrt (0.4122214708f * r + 0.5363325363f * g + 0.0514459929f * b) };
+    const auto m { std::cbrt (0.2119034982f * r + 0.6806995451f * g + 0.1073969566f * b) };
+    const auto s { std::cbrt (0.0883024619f * r + 0.2817188376f * g + 0.6299787005f * b) };
+
+    return { 0.2104542553f * l + 0.7936177850f * m - 0.0040720468f * s,
+             1.9779984951f * l - 2.4285922050f * m + 0.4505937099f * s,
+             0.0259040371f * l + 0.7827717662f * m - 0.8086757660f * s };
+}
+
+std::array<float, 3> oklabToLinear (float L, float a, float b)
+{
+    const auto l_ { L + 0.3963377774f * a + 0.2158037573f * b };
+    const auto m_ { L - 0.1055613458f * a - 0.0638541728f * b };
+    const auto s_ { L - 0.0894841775f * a - 1.2914855480f * b };
+
+    const auto l { l_ * l_ * l_ };
+    const auto m { m_ * m_ * m_ };
+    const auto s { s_ * s_ * s_ };
+
+    return { 4.0767416621f * l - 3.3077115913f * m + 0.2309699292f * s,
+             -1.2684380046f * l + 2.6097574011f * m - 0.3413193965f * s,
+             -0.0041960863f * l - 0.7034186147f * m + 1.7076147010f * s };
+}
+} // namespace colour
+
+LinearRgbColourTraits::Lanes LinearRgbColourTraits::toLanes (const juce::Colour& c)
+{
+    const auto alpha { c.getFloatAlpha () };
+    return { colour::srgbToLinear (c.getFloatRed ()) * alpha,
+             colour::srgbToLinear (c.getFloatGreen ()) * alpha,
+             colour::srgbToLinear (c.getFloatBlue ()) * alpha, alpha };
+}
+
+juce::uint32 LinearRgbColourTraits::toARGB (const Lanes& lanes)
+{
+    const auto alpha { lanes[3] };
+    return colour::packARGB (colour::linearToSrgb (unpremultiply (lanes[0], alpha)),
+                             colour::linearToSrgb (unpremultiply (lanes[1], alpha)),
+                             colour::linearToSrgb (unpremultiply (lanes[2], alpha)), alpha);
+}
+
+void LinearRgbColourTraits::toARGB (const float* const* lanes, juce::uint32* dest, int count)
+{
+    const float* r { lanes[0] };
+    const float* g { lanes[1] };
+    const float* b { lanes[2] };
+    const float* alpha { lanes[3] };
+
+    for (int i { 0 }; i < count; ++i)
+    {
+        const auto scale { (alpha[i] > 0.f) ? 1.f / alpha[i] : 0.f };
+        dest[i] = colour::packARGB (colour::linearToSrgb (r[i] * scale),
+                                    colour::linearToSrgb (g[i] * scale),
+                                    colour::linearToSrgb (b[i] * scale), alpha[i]);
+    }
+}
+
+OklabColourTraits::Lanes OklabColourTraits::toLanes (const juce::Colour& c)
+{
+    const auto alpha { c.getFloatAlpha () };
+    const auto lab { colour::linearToOklab (colour::srgbToLinear (c.getFloatRed ()),
+                                            colour::srgbToLinear (c.getFloatGreen ()),
+                                            colour::srgbToLinear (c.getFloatBlue ())) };
+    return { lab[0] * alpha, lab[1] * alpha, lab[2] * alpha, alpha };
+}
+
+juce::uint32 OklabColourTraits::toARGB (const Lanes& lanes)
+{
+    const auto alpha { lanes[3] };
+    const auto rgb { colour::oklabToLinear (unpremultiply (lanes[0], alpha),
+                                            unpremultiply (lanes[1], alpha),
+                                            unpremultiply (lanes[2], alpha)) };
+    return colour::packARGB (colour::linearToSrgb (rgb[0]), colour::linearToSrgb (rgb[1]),
+                             colour::linearToSrgb (rgb[2]), alpha);
+}
+
+void OklabColourTraits::toARGB (const float* const* lanes, juce::uint32* dest, int count)
+{
+    const float* L { lanes[0] };
+    const float* a { lanes[1] };
+    const float* b { lanes[2] };
+    const float* alpha { lanes[3] };
+
+    for (int i { 0 }; i < count; ++i)
+    {
+        const auto scale { (alpha[i] > 0.f) ? 1.f / alpha[i] : 0.f };
+        const auto rgb { colour::oklabToLinear (L[i] * scale, a[i] * scale, b[i] * scale) };
+        dest[i] = colour::packARGB (colour::linearToSrgb (rgb[0]), colour::linearToSrgb (rgb[1]),
+                                    colour::linearToSrgb (rgb[2]), alpha[i]);
+    }
+}
+
+OklchColourTraits::Lanes OklchColourTraits::toLanes (const juce::Colour& c)
+{
+    const auto alpha { c.getFloatAlpha () };
+    const auto lab { colour::linearToOklab (colour::srgbToLinear (c.getFloatRed ()),
+                                            colour::srgbToLinear (c.getFloatGreen ()),
+                                            colour::srgbToLinear (c.getFloatBlue ())) };
+    const auto chroma { std::hypot (lab[1], lab[2]) };
+    const auto hue { (chroma < kMinChroma) ? 0.f : std::atan2 (lab[2], lab[1]) };
+    return { lab[0] * alpha, chroma * alpha, hue, alpha };
+}
+
+void OklchColourTraits::prepare (Lanes& from, Lanes& to)
+{
+    // a grey has no hue of its own, so only the chroma should change.
+    const auto fromGrey { unpremultiply (from[1], from[3]) < kMinChroma };
+    const auto toGrey { unpremultiply (to[1], to[3]) < kMinChroma };
+    if (fromGrey && !toGrey)
+        from[2] = to[2];
+    else if (toGrey && !fromGrey)
+        to[2] = from[2];
+
+    constexpr auto pi { juce::MathConstants<float>::pi };
+    if (to[2] - from[2] > pi)
+        to[2] -= 2.f * pi;
+    else if (to[2] - from[2] < -pi)
+        to[2] += 2.f * pi;
+}
+
+juce::uint32 OklchColourTraits::toARGB (const Lanes& lanes)
+{
+    const auto alpha { lanes[3] };
+    const auto L { unpremultiply (lanes[0], alpha) };
+    const auto chroma { unpremultiply (lanes[1], alpha) };
+    const auto rgb { colour::oklabToLinear (L, chroma * std::cos (lanes[2]),
+                                            chroma * std::sin (lanes[2])) };
+    return colour::packARGB (colour::linearToSrgb (rgb[0]), colour::linearToSrgb (rgb[1]),
+                             colour::linearToSrgb (rgb[2]), alpha);
+}
+
+void OklchColourTraits::toARGB (const float* const* lanes, juce::uint32* dest, int count)
+{
+    const float* L { lanes[0] };
+    const float* chroma { lanes[1] };
+    const float* hue { lanes[2] };
+    const float* alpha { lanes[3] };
+
+    for (int i { 0 }; i < count; ++i)
+    {
+        const auto scale { (alpha[i] > 0.f) ? 1.f / alpha[i] : 0.f };
+        const auto c { chroma[i] * scale };
+        const auto rgb { colour::oklabToLinear (L[i] * scale, c * std::cos (hue[i]),
+                                                c * std::sin (hue[i])) };
+        dest[i] = colour::packARGB (colour::linearToSrgb (rgb[0]), colour::linearToSrgb (rgb[1]),
+                                    colour::linearToSrgb (rgb[2]), alpha[i]);
+    }
+}
+
+#ifdef qRunUnitTests
+#include "test/test_ColourTraits.cpp"
+#endif
+
+} // namespace friz
@@ -0,0 +1,165 @@
+/*
+    Copyright (c) 2019-2023 Brett g Porter
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#pragma once
+
+#include "valueTraits.h"
+
+namespace friz
+{
+
+/**
+ * @brief Conversions between the colour spaces used by the colour traits below.
+ * All colour components are in the range 0..1.
+ */
+namespace colour
+{
+float srgbToLinear (float c);
+float linearToSrgb (float c);
+
+/**
+ * @brief Convert linear RGB to OKLab (https://bottosson.github.io/posts/oklab/)
+ * @return {L, a, b}
+ */
+std::array<float, 3> linearToOklab (float r, float g, float b);
+
+/**
+ * @brief Convert OKLab to linear RGB.
+ * @return {r, g, b}
+ */
+std::array<float, 3> oklabToLinear (float L, float a, float b);
+
+/**
+ * @brief Pack (straight, not premultiplied) sRGB components into the ARGB format
+ * used by `juce::Colour`, clamping to the valid range. Inline, so the batch
+ * conversions below don't make a call per colour.
+ */
+inline juce::uint32 packARGB (float r, float g, float b, float alpha)
+{
+    auto toByte = [] (float c)
+    { return static_cast<juce::uint32> (juce::jlimit (0.f, 1.f, c) * 255.f + 0.5f); };
+
+    return (toByte (alpha) << 24) | (toByte (r) << 16) | (toByte (g) << 8) | toByte (b);
+}
+} // namespace colour
+
+/**
+ * @brief Colours interpolated in linear (not gamma-encoded) RGB with
+ * premultiplied alpha, so mixing two colours doesn't darken through the middle,
+ * and fading between colours with different alpha doesn't pick up the colour of
+ * transparent pixels.
+ *
+ * Use with `TypedAnimation<juce::Colour, LinearRgbColourTraits>`.
+ */
+struct LinearRgbColourTraits
+{
+    static constexpr std::size_t laneCount { 4 };
+    using Lanes = std::array<float, laneCount>;
+
+    static Lanes toLanes (const juce::Colour& c);
+
+    static juce::Colour fromLanes (const Lanes& lanes) { return juce::Colour { toARGB (lanes) }; }
+
+    /**
+     * @return the lanes as a packed ARGB value.
+     */
+    static juce::uint32 toARGB (const Lanes& lanes);
+
+    /**
+     * @brief Convert many colours at once (e.g. values sampled from many colour
+     * animations) from lanes into packed ARGB values. The lanes are passed as
+     * separate arrays, one flat loop over all of them. Note that the gamma
+     * curve (and the cube roots and trig functions of the OKLab traits) mean
+     * the loop won't be vectorized unless the compiler has a vector maths
+     * library to call for them.
+     *
+     * @param lanes `laneCount` arrays of `count` values each.
+     * @param dest  array to fill with `count` ARGB values.
+     * @param count
+     */
+    static void toARGB (const float* const* lanes, juce::uint32* dest, int count);
+};
+
+/**
+ * @brief Colours interpolated in the perceptually uniform OKLab space with
+ * premultiplied alpha, so transitions move evenly in lightness and don't pass
+ * through muddy or unexpectedly bright colours.
+ *
+ * Use with `TypedAnimation<juce::Colour, OklabColourTraits>`.
+ */
+struct OklabColourTraits
+{
+    static constexpr std::size_t laneCount { 4 };
+    using Lanes = std::array<float, laneCount>;
+
+    static Lanes toLanes (const juce::Colour& c);
+
+    static juce::Colour fromLanes (const Lanes& lanes) { return juce::Colour { toARGB (lanes) }; }
+
+    /**
+     * @return the lanes as a packed ARGB value.
+     */
+    static juce::uint32 toARGB (const Lanes& lanes);
+
+    /**
+     * @brief Batch conversion to packed ARGB.
+     * @sa LinearRgbColourTraits::toARGB
+     */
+    static void toARGB (const float* const* lanes, juce::uint32* dest, int count);
+};
+
+/**
+ * @brief Colours interpolated in OKLCh, the polar form of OKLab, so that the
+ * hue turns around the colour wheel (taking the shorter way around) while
+ * lightness and chroma change evenly. Alpha is premultiplied into the
+ * lightness and chroma.
+ *
+ * Use with `TypedAnimation<juce::Colour, OklchColourTraits>`.
+ */
+struct OklchColourTraits
+{
+    static constexpr std::size_t laneCount { 4 };
+    using Lanes = std::array<float, laneCount>;
+
+    static Lanes toLanes (const juce::Colour& c);
+
+    static juce::Colour fromLanes (const Lanes& lanes) { return juce::Colour { toARGB (lanes) }; }
+
+    /**
+     * @brief Make sure we go the short way around the hue circle, and that
+     * greys (which have no hue) take the hue of the other colour.
+     */
+    static void prepare (Lanes& from, Lanes& to);
+
+    /**
+     * @return the lanes as a packed ARGB value.
+     */
+    static juce::uint32 toARGB (const Lanes& lanes);
+
+    /**
+     * @brief Batch conversion to packed ARGB.
+     * @sa LinearRgbColourTraits::toARGB
+     */
+    static void toARGB (const float* const* lanes, juce::uint32* dest, int count);
+};
+
+} // namespace friz
@@ -39,6 +39,11 @@ float Constant::generateNextValue (float /*progress*/)
     return endVal;
 }
 
+void Constant::generateBlock (float* values, int numValues)
+{
+    std::fill (values, values + numValues, endVal);
+}
+
 #ifdef qRunUnitTests
 #include "test/test_Constant.cpp"
 #endif
@@ -66,6 +66,8 @@ public:
 private:
     float generateNextValue (float progress) override;
 
+    void generateBlock (float* values, int numValues) override;
+
 private:
 };
 
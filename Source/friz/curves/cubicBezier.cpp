@@ -0,0 +1,166 @@
+/*
+    Copyright (c) 2019-2023 Brett g Porter
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "cubicBezier.h"
+
+namespace
+{
+constexpr int kNewtonIterations { 4 };
+constexpr float kNewtonMinSlope { 0.001f };
+constexpr int kBisectionIterations { 12 };
+constexpr float kBisectionPrecision { 0.0000001f };
+constexpr float kSampleStep { 1.f / (friz::CubicBezier::Solver::kTableSize - 1) };
+} // namespace
+
+namespace friz
+{
+
+CubicBezier::Solver::Solver (float x1, float y1, float x2, float y2)
+: isLinear { x1 == y1 && x2 == y2 }
+{
+    jassert (juce::isPositiveAndNotGreaterThan (x1, 1.f) &&
+             juce::isPositiveAndNotGreaterThan (x2, 1.f));
+
+    cx = 3.f * x1;
+    bx = 3.f * (x2 - x1) - cx;
+    ax = 1.f - cx - bx;
+
+    cy = 3.f * y1;
+    by = 3.f * (y2 - y1) - cy;
+    ay = 1.f - cy - by;
+
+    for (int i { 0 }; i < kTableSize; ++i)
+        samples[static_cast<size_t> (i)] = curveX (i * kSampleStep);
+}
+
+float CubicBezier::Solver::solve (float x) const
+{
+    if (isLinear || x <= 0.f || x >= 1.f)
+        return x;
+
+    return curveY (getTForX (x));
+}
+
+float CubicBezier::Solver::getTForX (float x) const
+{
+    // find the interval in the sample table that x falls in, and
+    // interpolate an initial guess from there.
+    size_t index { 1 };
+    while (index < kTableSize - 1 && samples[index] <= x)
+        ++index;
+    --index;
+
+    const auto intervalStart { index * kSampleStep };
+    const auto dist { (x - samples[index]) / (samples[index + 1] - samples[index]) };
+    auto t { intervalStart + dist * kSampleStep };
+
+    const auto initialSlope { slopeX (t) };
+    if (initialSlope >= kNewtonMinSlope)
+    {
+        for (int i { 0 }; i < kNewtonIterations; ++i)
+        {
+            const auto slope { slopeX (t) };
+            if (slope == 0.f)
+                break;
+            t -= (curveX (t) - x) / slope;
+        }
+        return t;
+    }
+
+    if (initialSlope == 0.f)
+        return t;
+
+    // too flat for Newton's method to converge reliably.
+    auto lower { intervalStart };
+    auto upper { intervalStart + kSampleStep };
+    for (int i { 0 }; i < kBisectionIterations; ++i)
+    {
+        t                = lower + (upper - lower) / 2.f;
+        const auto error { curveX (t) - x };
+        if (std::abs (error) < kBisectionPrecision)
+            break;
+
+        if (error > 0.f)
+            upper = t;
+        else
+            lower = t;
+    }
+    return t;
+}
+
+CubicBezier::CubicBezier (float startVal, float endVal, int duration, float x1, float y1,
+                          float x2, float y2)
+: TimedValue (startVal, endVal, duration)
+, solver { getSolver (x1, y1, x2, y2) }
+{
+    jassert (duration > 0);
+}
+
+std::shared_ptr<const CubicBezier::Solver> CubicBezier::getSolver (float x1, float y1,
+                                                                    float x2, float y2)
+{
+    // Solvers are shared by everything using the same control points, and
+    // released when the last of those goes away.
+    static juce::CriticalSection mutex;
+    static std::map<std::array<float, 4>, std::weak_ptr<const Solver>> cache;
+    // size of the cache after we last removed expired entries.
+    static size_t prunedSize { 0 };
+
+    const juce::ScopedLock lock { mutex };
+
+    auto& entry { cache[{ x1, y1, x2, y2 }] };
+    auto solver { entry.lock () };
+    if (solver == nullptr)
+    {
+        solver = std::make_shared<const Solver> (x1, y1, x2, y2);
+        entry  = solver;
+
+        // Drop the entries for solvers that have been released once the cache
+        // has doubled in size, so the cost of pruning is spread across inserts.
+        if (cache.size () > 2 * prunedSize)
+        {
+            for (auto it { cache.begin () }; it != cache.end ();)
+                it = it->second.expired () ? cache.erase (it) : std::next (it);
+            prunedSize = cache.size ();
+        }
+    }
+    return solver;
+}
+
+float CubicBezier::generateNextValue (float progress)
+{
+    return scale (solver->solve (progress));
+}
+
+void CubicBezier::generateBlock (float* values, int numValues)
+{
+    const auto& curve { *solver };
+    const auto range { endVal - startVal };
+    for (int i { 0 }; i < numValues; ++i)
+        values[i] = startVal + curve.solve (values[i]) * range;
+}
+
+#ifdef qRunUnitTests
+#include "test/test_CubicBezier.cpp"
+#endif
+
+} // namespace friz
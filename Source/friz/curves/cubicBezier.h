@@ -0,0 +1,109 @@
+/*
+    Copyright (c) 2019-2023 Brett g Porter
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#pragma once
+
+#include "animatedValue.h"
+
+namespace friz
+{
+/**
+ * @class CubicBezier
+ * @brief Easing defined by a cubic bezier curve from (0, 0) to (1, 1) with two
+ * control points, the same as CSS's `cubic-bezier(x1, y1, x2, y2)`.
+ *
+ * Finding the curve's y for a given x means solving the curve for its
+ * parameter t. Each set of control points gets a table of samples along the
+ * curve that's calculated once and shared by every value that uses those
+ * points; we start from the table and refine with a few iterations of
+ * Newton-Raphson, falling back to bisection where the curve is too flat for
+ * that to converge.
+ */
+class CubicBezier : public TimedValue
+{
+public:
+    /**
+     * @class Solver
+     * @brief Calculates points on one curve. Immutable, so safe to share.
+     */
+    class Solver
+    {
+    public:
+        Solver (float x1, float y1, float x2, float y2);
+
+        /**
+         * @param x position in time (0..1)
+         * @return position along the curve.
+         */
+        float solve (float x) const;
+
+    private:
+        float getTForX (float x) const;
+
+        float curveX (float t) const { return ((ax * t + bx) * t + cx) * t; }
+        float curveY (float t) const { return ((ay * t + by) * t + cy) * t; }
+        float slopeX (float t) const { return (3.f * ax * t + 2.f * bx) * t + cx; }
+
+    public:
+        static constexpr int kTableSize { 11 };
+
+    private:
+        /// @brief polynomial coefficients
+        float ax, bx, cx, ay, by, cy;
+        /// @brief control points are on the diagonal, so y == x.
+        bool isLinear;
+        /// @brief x values at evenly spaced values of t.
+        std::array<float, kTableSize> samples;
+    };
+
+    /**
+     * @brief Construct a new CubicBezier value.
+     *
+     * @param startVal
+     * @param endVal
+     * @param duration in ms
+     * @param x1 first control point; x must be in 0..1
+     * @param y1
+     * @param x2 second control point; x must be in 0..1
+     * @param y2
+     */
+    CubicBezier (float startVal, float endVal, int duration, float x1, float y1, float x2,
+                 float y2);
+
+    /**
+     * @brief Get the (shared) solver for a set of control points, creating
+     * it if needed.
+     *
+     * @return std::shared_ptr<const Solver>
+     */
+    static std::shared_ptr<const Solver> getSolver (float x1, float y1, float x2, float y2);
+
+private:
+    float generateNextValue (float progress) override;
+
+    void generateBlock (float* values, int numValues) override;
+
+private:
+    std::shared_ptr<const Solver> solver;
+};
+
+} // namespace friz
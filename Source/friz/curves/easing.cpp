@@ -42,6 +42,13 @@ float EaseIn::generateNextValue ()
     return currentVal + slewRate * (endVal - currentVal);
 }
 
+bool EaseIn::getIntegratorState (FixedStepIntegrator::State& state) const
+{
+    state.model = FixedStepIntegrator::Model::slew;
+    state.rate  = slewRate;
+    return true;
+}
+
 EaseOut::EaseOut (float startVal, float endVal, float tolerance, float slewRate)
 : EasingCurve (startVal, endVal, tolerance, slewRate)
 , currentRate { 0.01f }
@@ -58,6 +65,19 @@ float EaseOut::generateNextValue ()
     return val;
 }
 
+bool EaseOut::getIntegratorState (FixedStepIntegrator::State& state) const
+{
+    state.model = FixedStepIntegrator::Model::accelerate;
+    state.rate  = currentRate;
+    state.scale = slewRate;
+    return true;
+}
+
+void EaseOut::setIntegratorState (const FixedStepIntegrator::State& state)
+{
+    currentRate = state.rate;
+}
+
 #ifdef qRunUnitTests
 #include "test/test_Easing.cpp"
 #endif
@@ -55,10 +55,61 @@ public:
      */
     EaseIn (float startVal, float endVal, float tolerance, float slewRate);
 
+protected:
+    bool getIntegratorState (FixedStepIntegrator::State& state) const override;
+
 private:
     float generateNextValue () override;
 };
 
+/**
+ * @class TargetMailbox
+ * @brief Passes new target values to a `SmoothedValue` from any thread
+ * without locking. Each post overwrites any target that hasn't been
+ * picked up yet, so the value only ever sees the latest one.
+ */
+class TargetMailbox
+{
+public:
+    TargetMailbox () { jassert (slot.is_lock_free ()); }
+
+    /**
+     * @brief Post a new target; a single relaxed atomic store.
+     *
+     * @param target
+     */
+    void post (float target) noexcept
+    {
+        std::uint32_t bits;
+        std::memcpy (&bits, &target, sizeof (bits));
+        slot.store (kPending | bits, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Take the most recently posted target, if there's one we haven't
+     * already taken.
+     *
+     * @param target set to the new target.
+     * @return true if there was a new target.
+     */
+    bool collect (float& target) noexcept
+    {
+        const auto value { slot.exchange (0, std::memory_order_relaxed) };
+        if ((value & kPending) == 0)
+            return false;
+
+        const auto bits { static_cast<std::uint32_t> (value) };
+        std::memcpy (&target, &bits, sizeof (target));
+        return true;
+    }
+
+private:
+    /// @brief flag (above the 32 bits of the float) marking an unread target.
+    static constexpr std::uint64_t kPending { std::uint64_t { 1 } << 32 };
+
+    std::atomic<std::uint64_t> slot { 0 };
+};
+
 /**
  * @brief An animated value whose end value can be changed while the animation
  *        is in progress.
@@ -72,15 +123,35 @@ public:
     }
 
     /**
-     * @brief Update the target value while the animation is running.
+     * @brief Get a mailbox that other threads (e.g. the audio or MIDI thread)
+     * can use to feed us new targets at a high rate, without locking the
+     * animator or looking up the animation. Each frame we pick up the most
+     * recent target that was posted.
      *
-     * @param newTarget
+     * Call this from the thread that owns the animation (e.g. when creating it)
+     * and hand the mailbox to the producer; it stays valid (posts are
+     * just ignored) after this value is deleted.
+     *
+     * @return std::shared_ptr<TargetMailbox>
      */
-    bool updateTarget (float newTarget) override
+    std::shared_ptr<TargetMailbox> getTargetMailbox ()
     {
-        endVal = newTarget;
-        return true;
+        if (mailbox == nullptr)
+            mailbox = std::make_shared<TargetMailbox> ();
+        return mailbox;
     }
+
+    float getNextValue (int msElapsed, int msSinceLastUpdate) override
+    {
+        if (float target; mailbox != nullptr && mailbox->collect (target))
+            updateTarget (target);
+
+        return EaseIn::getNextValue (msElapsed, msSinceLastUpdate);
+    }
+
+private:
+    /// @brief created on request, shared with producers.
+    std::shared_ptr<TargetMailbox> mailbox;
 };
 
 /**
@@ -100,6 +171,11 @@ public:
      */
     EaseOut (float startVal, float endVal, float tolerance, float slewRate);
 
+protected:
+    bool getIntegratorState (FixedStepIntegrator::State& state) const override;
+
+    void setIntegratorState (const FixedStepIntegrator::State& state) override;
+
 private:
     float generateNextValue () override;
 
@@ -0,0 +1,230 @@
+/*
+    Copyright (c) 2019-2023 Brett g Porter
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "integrator.h"
+
+namespace friz
+{
+
+int FixedStepIntegrator::add (const State& state)
+{
+    auto& bank { getBank (state.model) };
+
+    size_t index;
+    if (!bank.freeList.empty ())
+    {
+        index = static_cast<size_t> (bank.freeList.back ());
+        bank.freeList.pop_back ();
+    }
+    else
+    {
+        index = bank.size ();
+        bank.value.push_back (0.f);
+        bank.target.push_back (0.f);
+        bank.tolerance.push_back (0.f);
+        bank.rate.push_back (0.f);
+        bank.scale.push_back (0.f);
+        bank.velocity.push_back (0.f);
+        bank.status.push_back (kFree);
+    }
+
+    bank.value[index]     = state.value;
+    bank.target[index]    = state.target;
+    bank.tolerance[index] = state.tolerance;
+    bank.rate[index]      = state.rate;
+    bank.scale[index]     = state.scale;
+    bank.velocity[index]  = state.velocity;
+    bank.status[index]    = state.finished ? kFinished : kWaiting;
+
+    ++liveCount;
+    return static_cast<int> (index << 2) | static_cast<int> (state.model);
+}
+
+void FixedStepIntegrator::release (int handle)
+{
+    auto& bank { getBank (getModel (handle)) };
+    const auto index { getIndex (handle) };
+    jassert (index < bank.size () && bank.status[index] != kFree);
+
+    bank.status[index] = kFree;
+    bank.freeList.push_back (static_cast<int> (index));
+    --liveCount;
+}
+
+void FixedStepIntegrator::start (int handle, int steps)
+{
+    const auto model { getModel (handle) };
+    auto& bank { getBank (model) };
+    const auto index { getIndex (handle) };
+
+    if (bank.status[index] != kWaiting)
+        return;
+
+    bank.status[index] = kRunning;
+    for (int step { 0 }; step < steps && bank.status[index] == kRunning; ++step)
+    {
+        switch (model)
+        {
+            case Model::slew: stepSlew (bank, index); break;
+            case Model::accelerate: stepAccelerate (bank, index); break;
+            case Model::spring: stepSpring (bank, index); break;
+        }
+    }
+}
+
+void FixedStepIntegrator::advance (int steps)
+{
+    if (steps <= 0 || liveCount == 0)
+        return;
+
+    // Take each 1 ms step for every running value of a model before moving on
+    // to the next step, so the inner loops run across contiguous arrays of
+    // independent values.
+    auto& slew { getBank (Model::slew) };
+    auto& accelerate { getBank (Model::accelerate) };
+    auto& spring { getBank (Model::spring) };
+
+    for (int step { 0 }; step < steps; ++step)
+    {
+        for (size_t i = 0; i < slew.size (); ++i)
+        {
+            if (slew.status[i] == kRunning)
+                stepSlew (slew, i);
+        }
+
+        for (size_t i = 0; i < accelerate.size (); ++i)
+        {
+            if (accelerate.status[i] == kRunning)
+                stepAccelerate (accelerate, i);
+        }
+
+        for (size_t i = 0; i < spring.size (); ++i)
+        {
+            if (spring.status[i] == kRunning)
+                stepSpring (spring, i);
+        }
+    }
+}
+
+void FixedStepIntegrator::setTarget (int handle, float target)
+{
+    auto& bank { getBank (getModel (handle)) };
+    const auto index { getIndex (handle) };
+    bank.target[index] = target;
+
+    // a spring keeps its velocity, but must accelerate toward the new target.
+    if (getModel (handle) == Model::spring)
+        bank.rate[index] = std::copysign (bank.rate[index], target - bank.value[index]);
+}
+
+void FixedStepIntegrator::finish (int handle, bool moveToTarget)
+{
+    auto& bank { getBank (getModel (handle)) };
+    const auto index { getIndex (handle) };
+    if (moveToTarget)
+        bank.value[index] = bank.target[index];
+    bank.status[index] = kFinished;
+}
+
+float FixedStepIntegrator::getValue (int handle) const
+{
+    return getBank (getModel (handle)).value[getIndex (handle)];
+}
+
+bool FixedStepIntegrator::isFinished (int handle) const
+{
+    return getBank (getModel (handle)).status[getIndex (handle)] == kFinished;
+}
+
+bool FixedStepIntegrator::isStarted (int handle) const
+{
+    return getBank (getModel (handle)).status[getIndex (handle)] != kWaiting;
+}
+
+FixedStepIntegrator::State FixedStepIntegrator::getState (int handle) const
+{
+    const auto model { getModel (handle) };
+    const auto& bank { getBank (model) };
+    const auto index { getIndex (handle) };
+
+    State state;
+    state.model     = model;
+    state.value     = bank.value[index];
+    state.target    = bank.target[index];
+    state.tolerance = bank.tolerance[index];
+    state.rate      = bank.rate[index];
+    state.scale     = bank.scale[index];
+    state.velocity  = bank.velocity[index];
+    state.finished  = bank.status[index] == kFinished;
+    return state;
+}
+
+bool FixedStepIntegrator::snapToTarget (Bank& bank, size_t i)
+{
+    if (std::fabs (bank.value[i] - bank.target[i]) < bank.tolerance[i])
+    {
+        bank.value[i]  = bank.target[i];
+        bank.status[i] = kFinished;
+        return true;
+    }
+    return false;
+}
+
+void FixedStepIntegrator::stepSlew (Bank& bank, size_t i)
+{
+    bank.value[i] += bank.rate[i] * (bank.target[i] - bank.value[i]);
+    snapToTarget (bank, i);
+}
+
+void FixedStepIntegrator::stepAccelerate (Bank& bank, size_t i)
+{
+    bank.value[i] += bank.rate[i] * (bank.target[i] - bank.value[i]);
+    // limit the slew to prevent us blowing up.
+    bank.rate[i] = std::min (0.95f, bank.rate[i] * bank.scale[i]);
+    snapToTarget (bank, i);
+}
+
+void FixedStepIntegrator::stepSpring (Bank& bank, size_t i)
+{
+    const auto target { bank.target[i] };
+    const auto damping { bank.scale[i] };
+    const auto prev { bank.value[i] };
+    bank.velocity[i] += bank.rate[i];
+    auto next { prev + bank.velocity[i] };
+
+    // see if we have crossed over the end value; if so, reverse and
+    // dampen the oscillation (see `Spring::generateNextValue()`)
+    if ((target - prev) * (target - next) <= 0)
+    {
+        if (std::fabs (damping) < 0.001)
+            next = target;
+        else
+        {
+            bank.rate[i] = -1 * bank.rate[i] * damping;
+            bank.velocity[i] *= -damping;
+        }
+    }
+    bank.value[i] = next;
+    snapToTarget (bank, i);
+}
+
+} // namespace friz
@@ -0,0 +1,187 @@
+/*
+    Copyright (c) 2019-2023 Brett g Porter
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <vector>
+
+namespace friz
+{
+
+/**
+ * @class FixedStepIntegrator
+ * @brief Steps the state of many physics-style values (springs and slew-based
+ * easing curves) together, at the same fixed 1 ms timestep that the
+ * `ToleranceValue` classes use internally.
+ *
+ * State is kept in contiguous arrays, one bank per kind of model, so advancing
+ * hundreds of values is a handful of tight loops instead of a virtual call per
+ * value per step. An `Animator` owns one of these when batched physics is
+ * enabled; values attach themselves to it with `ToleranceValue::attachIntegrator()`.
+ */
+class FixedStepIntegrator
+{
+public:
+    enum class Model
+    {
+        slew,       ///< EaseIn: move a fixed fraction of the remaining distance each step.
+        accelerate, ///< EaseOut: like slew, but the fraction grows each step.
+        spring      ///< Spring: accelerate toward the target, oscillate on overshoot.
+    };
+
+    /**
+     * @brief Everything needed to step one value; the meaning of the
+     * parameters depends on the model.
+     */
+    struct State
+    {
+        Model model { Model::slew };
+        float value { 0.f };
+        float target { 0.f };
+        float tolerance { 0.f };
+        /// slew: slew rate; accelerate: current rate; spring: acceleration.
+        float rate { 0.f };
+        /// accelerate: rate multiplier; spring: damping.
+        float scale { 0.f };
+        /// spring: velocity.
+        float velocity { 0.f };
+        bool finished { false };
+    };
+
+    FixedStepIntegrator () = default;
+
+    /**
+     * @brief Add a value. It won't be stepped by `advance()` until it's been
+     * started with `start()`.
+     *
+     * @param state initial state
+     * @return int handle used to refer to this value.
+     */
+    int add (const State& state);
+
+    /**
+     * @brief Remove a value, making its space available for re-use.
+     *
+     * @param handle
+     */
+    void release (int handle);
+
+    /**
+     * @brief Bring a value up to date by stepping it on its own, then include it
+     * in every subsequent call to `advance()`. A value's first steps can't be
+     * batched because its animation may begin partway through a frame.
+     *
+     * @param handle
+     * @param steps number of 1 ms steps to take now.
+     */
+    void start (int handle, int steps);
+
+    /**
+     * @brief Step all of the running values.
+     *
+     * @param steps number of 1 ms steps.
+     */
+    void advance (int steps);
+
+    /**
+     * @brief Change the target of a value.
+     */
+    void setTarget (int handle, float target);
+
+    /**
+     * @brief Stop stepping a value, optionally moving it to its target.
+     */
+    void finish (int handle, bool moveToTarget);
+
+    float getValue (int handle) const;
+
+    bool isFinished (int handle) const;
+
+    bool isStarted (int handle) const;
+
+    /**
+     * @brief Retrieve the full state of a value, e.g. to hand it back to an
+     * object that will step itself.
+     */
+    State getState (int handle) const;
+
+    /**
+     * @return true if there are any values that haven't been released.
+     */
+    bool isEmpty () const { return liveCount == 0; }
+
+private:
+    enum Status : juce::uint8
+    {
+        kFree,
+        kWaiting,
+        kRunning,
+        kFinished
+    };
+
+    /**
+     * @brief Structure-of-arrays storage for all the values of one model.
+     */
+    struct Bank
+    {
+        std::vector<float> value;
+        std::vector<float> target;
+        std::vector<float> tolerance;
+        std::vector<float> rate;
+        std::vector<float> scale;
+        std::vector<float> velocity;
+        std::vector<juce::uint8> status;
+        std::vector<int> freeList;
+
+        size_t size () const { return status.size (); }
+    };
+
+    Bank& getBank (Model model) { return banks[static_cast<size_t> (model)]; }
+
+    const Bank& getBank (Model model) const { return banks[static_cast<size_t> (model)]; }
+
+    /**
+     * @brief Take a single 1 ms step of one running value.
+     */
+    static void stepSlew (Bank& bank, size_t i);
+    static void stepAccelerate (Bank& bank, size_t i);
+    static void stepSpring (Bank& bank, size_t i);
+
+    /**
+     * @brief If a value is within tolerance of its target, snap to the
+     * target and mark it finished.
+     * @return true if finished.
+     */
+    static bool snapToTarget (Bank& bank, size_t i);
+
+    static Model getModel (int handle) { return static_cast<Model> (handle & 0x03); }
+
+    static size_t getIndex (int handle) { return static_cast<size_t> (handle >> 2); }
+
+private:
+    std::array<Bank, 3> banks;
+    int liveCount { 0 };
+};
+
+} // namespace friz
@@ -0,0 +1,104 @@
+/*
+    Copyright (c) 2019-2023 Brett g Porter
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "keyframe.h"
+
+namespace
+{
+std::vector<friz::KeyframeValue::Key> sortKeys (std::vector<friz::KeyframeValue::Key> keys)
+{
+    jassert (!keys.empty ());
+    if (keys.empty ())
+        keys.push_back ({ 0, 0.f });
+
+    std::stable_sort (keys.begin (), keys.end (),
+                      [] (const auto& lhs, const auto& rhs) { return lhs.time < rhs.time; });
+    return keys;
+}
+} // namespace
+
+namespace friz
+{
+
+KeyframeValue::KeyframeValue (std::vector<Key> keys_)
+: TimedValue (0.f, 0.f, 0)
+, keys { sortKeys (std::move (keys_)) }
+{
+    jassert (keys.front ().time >= 0);
+    startVal = currentVal = keys.front ().value;
+    endVal                = keys.back ().value;
+    duration              = keys.back ().time;
+}
+
+float KeyframeValue::valueAt (int msElapsed)
+{
+    if (msElapsed >= duration)
+        return endVal;
+
+    return interpolate (static_cast<float> (msElapsed));
+}
+
+float KeyframeValue::generateNextValue (float progress)
+{
+    return interpolate (progress * duration);
+}
+
+float KeyframeValue::interpolate (float time)
+{
+    if (time <= keys.front ().time)
+        return keys.front ().value;
+    if (time >= keys.back ().time)
+        return keys.back ().value;
+
+    const auto segment { findSegment (time) };
+    const auto& from { keys[segment] };
+    const auto& to { keys[segment + 1] };
+
+    const auto progress { (time - from.time) / static_cast<float> (to.time - from.time) };
+    const auto curvePoint { (to.easing != nullptr) ? to.easing (progress) : progress };
+    return from.value + curvePoint * (to.value - from.value);
+}
+
+size_t KeyframeValue::findSegment (float time)
+{
+    // usually we're still in the same segment as last time, or have moved
+    // into the next one.
+    if (keys[cursor].time <= time)
+    {
+        if (time < keys[cursor + 1].time)
+            return cursor;
+        if (cursor + 2 < keys.size () && time < keys[cursor + 2].time)
+            return ++cursor;
+    }
+
+    // otherwise, the segment starts at the last key at or before this time.
+    const auto it { std::upper_bound (keys.begin (), keys.end (), time,
+                                      [] (float t, const Key& key) { return t < key.time; }) };
+    cursor = static_cast<size_t> (std::distance (keys.begin (), it)) - 1;
+    return cursor;
+}
+
+#ifdef qRunUnitTests
+#include "test/test_Keyframe.cpp"
+#endif
+
+} // namespace friz
@@ -0,0 +1,106 @@
+/*
+    Copyright (c) 2019-2023 Brett g Porter
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#pragma once
+
+#include "parametric.h"
+
+namespace friz
+{
+/**
+ * @class KeyframeValue
+ * @brief A value that moves through a list of keyframes, each with its own
+ * easing curve. A multi-stage motion can be a single value object instead
+ * of a `Sequence` of separate animations.
+ *
+ * Keys are kept sorted in a single array. During normal playback we remember
+ * the segment we're in and usually find the next one in constant time; jumps
+ * (e.g. seeking on a timeline) use a binary search.
+ */
+class KeyframeValue : public TimedValue
+{
+public:
+    struct Key
+    {
+        /// @brief time of this key in ms from the start of the value.
+        int time;
+        /// @brief value at that time.
+        float value;
+        /// @brief easing used to move from the previous key to this one;
+        /// nullptr for linear.
+        Parametric::EasingFn easing { nullptr };
+    };
+
+    /**
+     * @brief Construct a new KeyframeValue. Before the first key, we hold its value;
+     * we finish at the time of the last key.
+     *
+     * @param keys at least one key; will be sorted by time.
+     */
+    KeyframeValue (std::vector<Key> keys);
+
+    float valueAt (int msElapsed) override;
+
+    /**
+     * @brief Our keys are fixed; we can't be retargeted.
+     */
+    bool updateTarget (float /*newTarget*/) override { return false; }
+
+    /**
+     * @return the number of keys.
+     */
+    size_t getKeyCount () const { return keys.size (); }
+
+    /**
+     * @param index
+     * @return one of our keys.
+     */
+    const Key& getKey (size_t index) const { return keys[index]; }
+
+private:
+    float generateNextValue (float progress) override;
+
+    /**
+     * @brief Calculate the value at a point in time.
+     *
+     * @param time in ms, may be fractional when rendering at audio rate.
+     * @return float
+     */
+    float interpolate (float time);
+
+    /**
+     * @brief Find the segment (the index of the key that starts it) that
+     * contains this time, which must be between the first and last keys.
+     *
+     * @param time
+     * @return size_t
+     */
+    size_t findSegment (float time);
+
+private:
+    std::vector<Key> keys;
+
+    /// @brief index of the key that starts the segment we were last in.
+    size_t cursor { 0 };
+};
+
+} // namespace friz
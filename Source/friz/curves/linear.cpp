@@ -37,6 +37,13 @@ float Linear::generateNextValue (float progress)
     return scale (progress);
 }
 
+void Linear::generateBlock (float* values, int numValues)
+{
+    const auto range { endVal - startVal };
+    for (int i { 0 }; i < numValues; ++i)
+        values[i] = startVal + values[i] * range;
+}
+
 #ifdef qRunUnitTests
 #include "test/test_Linear.cpp"
 #endif
@@ -43,6 +43,8 @@ public:
 
 private:
     float generateNextValue (float progress) override;
+
+    void generateBlock (float* values, int numValues) override;
 };
 
 } // namespace friz
@@ -76,85 +76,74 @@ Parametric::Parametric (CurveType type, float startVal, float endVal, int durati
 
 Parametric::Parametric (float startVal, float endVal, int duration, CurveType type)
 : TimedValue (startVal, endVal, duration)
+, curve { getEasingFunction (type) }
+, easing { getEasingFunction (type) }
+{
+}
+
+Parametric::EasingFn Parametric::getEasingFunction (CurveType type)
 {
     switch (type)
     {
         case kEaseInSine:
-            curve = [] (float x) { return 1 - cos_f ((x * kPi) / 2); };
-            break;
+            return [] (float x) { return 1 - cos_f ((x * kPi) / 2); };
 
         case kEaseOutSine:
-            curve = [] (float x) { return sin_f (x * kPi / 2); };
-            break;
+            return [] (float x) { return sin_f (x * kPi / 2); };
 
         case kEaseInOutSine:
-            curve = [] (float x) { return -(cos_f (kPi * x) - 1) / 2; };
-            break;
+            return [] (float x) { return -(cos_f (kPi * x) - 1) / 2; };
 
         case kEaseInQuad:
-            curve = [] (float x) { return x * x; };
-            break;
+            return [] (float x) { return x * x; };
 
         case kEaseOutQuad:
-            curve = [] (float x) { return 1 - (1 - x) * (1 - x); };
-            break;
+            return [] (float x) { return 1 - (1 - x) * (1 - x); };
 
         case kEaseInOutQuad:
-            curve = [] (float x)
+            return [] (float x)
             { return (x < 0.5f) ? (2 * x * x) : (1 - pow_f (-2 * x + 2, 2) / 2); };
-            break;
 
         case kEaseInCubic:
-            curve = [] (float x) { return x * x * x; };
-            break;
+            return [] (float x) { return x * x * x; };
 
         case kEaseOutCubic:
-            curve = [] (float x) { return 1 - pow_f (1 - x, 3); };
-            break;
+            return [] (float x) { return 1 - pow_f (1 - x, 3); };
 
         case kEaseInOutCubic:
-            curve = [] (float x)
+            return [] (float x)
             { return (x < 0.5f) ? 4 * x * x * x : 1 - pow_f (-2 * x + 2, 3) / 2; };
-            break;
 
         case kEaseInQuartic:
-            curve = [] (float x) { return x * x * x * x; };
-            break;
+            return [] (float x) { return x * x * x * x; };
 
         case kEaseOutQuartic:
-            curve = [] (float x) { return 1 - pow_f (1 - x, 4); };
-            break;
+            return [] (float x) { return 1 - pow_f (1 - x, 4); };
 
         case kEaseInOutQuartic:
-            curve = [] (float x)
+            return [] (float x)
             { return (x < 0.5f) ? 8 * x * x * x * x : 1 - pow_f (-2 * x + 2, 4) / 2; };
-            break;
 
         case kEaseInQuintic:
-            curve = [] (float x) { return x * x * x * x * x; };
-            break;
+            return [] (float x) { return x * x * x * x * x; };
 
         case kEaseOutQuintic:
-            curve = [] (float x) { return 1 - pow_f (1 - x, 5); };
-            break;
+            return [] (float x) { return 1 - pow_f (1 - x, 5); };
 
         case kEaseInOutQuintic:
-            curve = [] (float x) {
+            return [] (float x) {
                 return (x < 0.5f) ? 16 * x * x * x * x * x
                                   : 1 - pow_f (-2 * x + 2, 5) / 2;
             };
-            break;
         case kEaseInExpo:
-            curve = [] (float x)
+            return [] (float x)
             { return (x < kZeroIsh) ? 0.f : pow_f (2, 10 * x - 10); };
-            break;
 
         case kEaseOutExpo:
-            curve = [] (float x) { return (x > kOneIsh) ? 1.f : 1 - pow_f (2, -10 * x); };
-            break;
+            return [] (float x) { return (x > kOneIsh) ? 1.f : 1 - pow_f (2, -10 * x); };
 
         case kEaseInOutExpo:
-            curve = [] (float x)
+            return [] (float x)
             {
                 if (x < kZeroIsh)
                     return 0.f;
@@ -165,37 +154,31 @@ Parametric::Parametric (float startVal, float endVal, int duration, CurveType ty
 
                 return (2 - pow_f (2, -20 * x + 10)) / 2;
             };
-            break;
 
         case kEaseInCirc:
-            curve = [] (float x) { return 1 - std::sqrt (1 - pow_f (x, 2)); };
-            break;
+            return [] (float x) { return 1 - std::sqrt (1 - pow_f (x, 2)); };
 
         case kEaseOutCirc:
-            curve = [] (float x) { return std::sqrt (1 - pow_f (x - 1, 2)); };
-            break;
+            return [] (float x) { return std::sqrt (1 - pow_f (x - 1, 2)); };
 
         case kEaseInOutCirc:
-            curve = [] (float x)
+            return [] (float x)
             {
                 if (x < 0.5f)
                     return (1 - std::sqrt (1 - pow_f (2 * x, 2))) / 2;
 
                 return 0.5f * std::sqrt (1 - pow_f (-2 * x + 2, 2)) + 1;
             };
-            break;
 
         case kEaseInBack:
-            curve = [] (float x) { return (kC3 * x * x * x) - (kC1 * x * x); };
-            break;
+            return [] (float x) { return (kC3 * x * x * x) - (kC1 * x * x); };
 
         case kEaseOutBack:
-            curve = [] (float x)
+            return [] (float x)
             { return 1 + kC3 * pow_f (x - 1, 3) + kC1 * pow_f (x - 1, 2); };
-            break;
 
         case kEaseInOutBack:
-            curve = [] (float x)
+            return [] (float x)
             {
                 if (x < 0.5f)
                     return 0.5f * (pow_f (2 * x, 2) * ((kC2 + 1) * 2 * x - kC2));
@@ -203,10 +186,9 @@ Parametric::Parametric (float startVal, float endVal, int duration, CurveType ty
                 return 0.5f *
                        (pow_f (2 * x - 2, 2) * ((kC2 + 1) * (x * 2 - 2) + kC2) + 2);
             };
-            break;
 
         case kEaseInElastic:
-            curve = [] (float x) -> float
+            return [] (float x) -> float
             {
                 if (x < kZeroIsh)
                     return 0.f;
@@ -215,10 +197,9 @@ Parametric::Parametric (float startVal, float endVal, int duration, CurveType ty
 
                 return -pow_f (2, 10 * x - 10) * sin_f ((x * 10 - 10.75f) * kC4);
             };
-            break;
 
         case kEaseOutElastic:
-            curve = [] (float x) -> float
+            return [] (float x) -> float
             {
                 if (x < kZeroIsh)
                     return 0.f;
@@ -227,10 +208,9 @@ Parametric::Parametric (float startVal, float endVal, int duration, CurveType ty
 
                 return pow_f (2, -10 * x) * sin_f ((x * 10 - 0.75f) * kC4) + 1;
             };
-            break;
 
         case kEaseInOutElastic:
-            curve = [] (float x) -> float
+            return [] (float x) -> float
             {
                 if (x < kZeroIsh)
                     return 0.f;
@@ -242,37 +222,33 @@ Parametric::Parametric (float startVal, float endVal, int duration, CurveType ty
 
                 return 0.5f * (pow_f (2, -20 * x + 10) * sin_f (20 * x - 11.125f)) + 1;
             };
-            break;
 
         case kEaseInBounce:
-            curve = easeInBounce;
-            break;
+            return easeInBounce;
 
         case kEaseOutBounce:
-            curve = easeOutBounce;
-            break;
+            return easeOutBounce;
 
         case kEaseInOutBounce:
-            curve = [] (float x)
+            return [] (float x)
             {
                 if (x < 0.5f)
                     return 0.5f * (1 - easeOutBounce (1 - 2 * x));
 
                 return 0.5f * (1 + easeOutBounce (2 * x - 1));
             };
-            break;
 
         case kLinear:
         // fall through
         default:
-            curve = [] (float x) { return x; };
-            break;
+            return [] (float x) { return x; };
     }
 }
 
 void Parametric::SetCurve (CurveFn curve_)
 {
-    curve = curve_;
+    curve  = curve_;
+    easing = nullptr;
 }
 
 float Parametric::generateNextValue (float progress)
@@ -291,4 +267,26 @@ float Parametric::generateNextValue (float progress)
     return scale (curve (progress));
 }
 
+void Parametric::generateBlock (float* values, int numValues)
+{
+    const auto range { endVal - startVal };
+
+    if (easing != nullptr)
+    {
+        for (int i { 0 }; i < numValues; ++i)
+            values[i] = startVal + easing (values[i]) * range;
+    }
+    else if (curve != nullptr)
+    {
+        for (int i { 0 }; i < numValues; ++i)
+            values[i] = startVal + curve (values[i]) * range;
+    }
+    else
+    {
+        jassertfalse;
+        for (int i { 0 }; i < numValues; ++i)
+            values[i] = startVal + values[i] * range;
+    }
+}
+
 } // namespace friz
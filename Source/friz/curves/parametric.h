@@ -44,6 +44,10 @@ public:
     // that 0..1 range.
     using CurveFn = std::function<float (float)>;
 
+    // The built-in curves don't need any state, so they're also available as
+    // plain function pointers that can be stored and shared cheaply.
+    using EasingFn = float (*) (float);
+
     enum CurveType
     {
         kLinear = 0,
@@ -112,11 +116,26 @@ public:
      */
     void SetCurve (CurveFn curve);
 
+    /**
+     * @brief Get the function that implements one of the built-in curve types,
+     * for use by other classes that want to apply the same easing curves.
+     *
+     * @param type
+     * @return EasingFn mapping progress (0..1) onto curve position.
+     */
+    static EasingFn getEasingFunction (CurveType type);
+
 private:
     float generateNextValue (float progress) override;
 
+    void generateBlock (float* values, int numValues) override;
+
 private:
     CurveFn curve;
+
+    /// @brief if we're using one of the built-in curves, a direct pointer to
+    /// it so bulk rendering can skip the std::function dispatch.
+    EasingFn easing { nullptr };
 };
 
 } // namespace friz
\ No newline at end of file
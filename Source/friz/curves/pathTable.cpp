@@ -0,0 +1,144 @@
+/*
+    Copyright (c) 2019-2023 Brett g Porter
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "pathTable.h"
+
+namespace friz
+{
+
+PathTable::Ptr PathTable::create (const juce::Path& path, float tolerance)
+{
+    return std::make_shared<const PathTable> (path, tolerance);
+}
+
+PathTable::Ptr PathTable::createCatmullRom (const std::vector<juce::Point<float>>& points,
+                                            bool closed, float tolerance)
+{
+    jassert (points.size () >= 2);
+
+    const auto count { static_cast<int> (points.size ()) };
+    auto pointAt = [&] (int index)
+    {
+        if (closed)
+            return points[static_cast<size_t> ((index + count) % count)];
+        return points[static_cast<size_t> (juce::jlimit (0, count - 1, index))];
+    };
+
+    // each span of a (uniform) Catmull-Rom spline is a cubic bezier whose control
+    // points are set by the tangents at its ends.
+    juce::Path path;
+    path.startNewSubPath (points.front ());
+    const auto spanCount { closed ? count : count - 1 };
+    for (int i { 0 }; i < spanCount; ++i)
+    {
+        const auto p0 { pointAt (i - 1) };
+        const auto p1 { pointAt (i) };
+        const auto p2 { pointAt (i + 1) };
+        const auto p3 { pointAt (i + 2) };
+        path.cubicTo (p1 + (p2 - p0) / 6.f, p2 - (p3 - p1) / 6.f, p2);
+    }
+    if (closed)
+        path.closeSubPath ();
+
+    return create (path, tolerance);
+}
+
+PathTable::PathTable (const juce::Path& path, float tolerance)
+{
+    juce::PathFlatteningIterator it { path, juce::AffineTransform (), tolerance };
+    while (it.next ())
+    {
+        if (xs.empty () || !juce::approximatelyEqual (xs.back (), it.x1) ||
+            !juce::approximatelyEqual (ys.back (), it.y1))
+        {
+            // the start of the path, or a jump to a new sub-path, which
+            // doesn't add to the distance.
+            distances.push_back (distances.empty () ? 0.f : distances.back ());
+            xs.push_back (it.x1);
+            ys.push_back (it.y1);
+        }
+
+        distances.push_back (distances.back () +
+                             std::hypot (it.x2 - it.x1, it.y2 - it.y1));
+        xs.push_back (it.x2);
+        ys.push_back (it.y2);
+    }
+
+    // an empty path; stay at the origin.
+    if (xs.empty ())
+    {
+        distances.push_back (0.f);
+        xs.push_back (0.f);
+        ys.push_back (0.f);
+    }
+}
+
+size_t PathTable::findSegment (float distance, float& fraction) const
+{
+    fraction = 0.f;
+    if (distances.size () < 2 || distance <= 0.f)
+        return 0;
+
+    const auto lastSegment { distances.size () - 2 };
+    if (distance >= distances.back ())
+    {
+        fraction = 1.f;
+        return lastSegment;
+    }
+
+    const auto it { std::upper_bound (distances.begin (), distances.end (), distance) };
+    const auto index { std::min (static_cast<size_t> (std::distance (distances.begin (), it)) - 1,
+                                 lastSegment) };
+    const auto length { distances[index + 1] - distances[index] };
+    if (length > 0.f)
+        fraction = (distance - distances[index]) / length;
+    return index;
+}
+
+juce::Point<float> PathTable::getPoint (float distance) const
+{
+    float fraction;
+    const auto index { findSegment (distance, fraction) };
+    if (index + 1 >= xs.size ())
+        return { xs[index], ys[index] };
+
+    return { xs[index] + fraction * (xs[index + 1] - xs[index]),
+             ys[index] + fraction * (ys[index + 1] - ys[index]) };
+}
+
+PathTable::Position PathTable::getPosition (float distance) const
+{
+    float fraction;
+    const auto index { findSegment (distance, fraction) };
+    if (index + 1 >= xs.size ())
+        return { { xs[index], ys[index] }, 0.f };
+
+    const auto dx { xs[index + 1] - xs[index] };
+    const auto dy { ys[index + 1] - ys[index] };
+    return { { xs[index] + fraction * dx, ys[index] + fraction * dy }, std::atan2 (dy, dx) };
+}
+
+#ifdef qRunUnitTests
+#include "test/test_PathTable.cpp"
+#endif
+
+} // namespace friz
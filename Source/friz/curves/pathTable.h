@@ -0,0 +1,112 @@
+/*
+    Copyright (c) 2019-2023 Brett g Porter
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+namespace friz
+{
+/**
+ * @class PathTable
+ * @brief A path flattened into straight line segments, indexed by the
+ * distance along the path, so that moving along it at an even speed only
+ * needs a binary search and an interpolation.
+ *
+ * Tables are immutable once created, so a single table can be shared by any
+ * number of `PathAnimation` objects.
+ */
+class PathTable
+{
+public:
+    using Ptr = std::shared_ptr<const PathTable>;
+
+    /**
+     * @brief A position along the path.
+     */
+    struct Position
+    {
+        juce::Point<float> point;
+        /// @brief direction of the path at this point, in radians clockwise from
+        /// the positive x axis.
+        float angle;
+    };
+
+    /**
+     * @brief Flatten a path into a new table.
+     *
+     * @param path
+     * @param tolerance maximum distance between the path and its flattened version.
+     * @return Ptr
+     */
+    static Ptr create (const juce::Path& path, float tolerance = 0.25f);
+
+    /**
+     * @brief Create a table for a Catmull-Rom spline that passes through all of
+     * a list of points.
+     *
+     * @param points    at least 2 points to pass through.
+     * @param closed    true to join the last point back to the first.
+     * @param tolerance
+     * @return Ptr
+     */
+    static Ptr createCatmullRom (const std::vector<juce::Point<float>>& points,
+                                 bool closed = false, float tolerance = 0.25f);
+
+    PathTable (const juce::Path& path, float tolerance);
+
+    /**
+     * @return total length of the path.
+     */
+    float getLength () const { return distances.empty () ? 0.f : distances.back (); }
+
+    /**
+     * @param distance along the path (clamped to the path)
+     * @return the point at that distance.
+     */
+    juce::Point<float> getPoint (float distance) const;
+
+    /**
+     * @param distance along the path (clamped to the path)
+     * @return the point at that distance and the direction of the path there.
+     */
+    Position getPosition (float distance) const;
+
+private:
+    /**
+     * @brief Find the segment that contains a distance.
+     *
+     * @param distance
+     * @param fraction set to how far along the segment the distance is (0..1)
+     * @return index of the point at the start of the segment.
+     */
+    size_t findSegment (float distance, float& fraction) const;
+
+private:
+    /// @brief distance along the path to each point.
+    std::vector<float> distances;
+    /// @brief coordinates of each point.
+    std::vector<float> xs;
+    std::vector<float> ys;
+};
+
+} // namespace friz
@@ -0,0 +1,72 @@
+/*
+    Copyright (c) 2019-2023 Brett g Porter
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "sharedCurve.h"
+
+namespace friz
+{
+
+SharedCurve::SharedCurve (CurveSpec::Ptr spec_, float startVal, float endVal, int offset_)
+: AnimatedValue (startVal, endVal)
+, spec { std::move (spec_) }
+, offset { std::max (0, offset_) }
+{
+    jassert (spec != nullptr);
+}
+
+float SharedCurve::getNextValue (int msElapsed, int /*msSinceLastUpdate*/)
+{
+    // once canceled, we stay wherever the cancel left us.
+    if (canceled)
+        return currentVal;
+
+    return seek (msElapsed);
+}
+
+float SharedCurve::valueAt (int msElapsed)
+{
+    if (msElapsed >= getDuration ())
+        return endVal;
+
+    return calculate (static_cast<float> (msElapsed));
+}
+
+float SharedCurve::seek (int msElapsed)
+{
+    finished   = msElapsed >= getDuration ();
+    currentVal = valueAt (msElapsed);
+    return currentVal;
+}
+
+float SharedCurve::calculate (float time) const
+{
+    if (time <= offset)
+        return startVal;
+
+    return startVal + spec->apply ((time - offset) / spec->duration) * (endVal - startVal);
+}
+
+#ifdef qRunUnitTests
+#include "test/test_SharedCurve.cpp"
+#endif
+
+} // namespace friz
@@ -0,0 +1,143 @@
+/*
+    Copyright (c) 2019-2023 Brett g Porter
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#pragma once
+
+#include "parametric.h"
+
+namespace friz
+{
+/**
+ * @class CurveSpec
+ * @brief An immutable description of a time-based curve (its easing and
+ * duration) that can be shared by any number of `SharedCurve` values, e.g.
+ * when staggering the same motion across all of the items in a list.
+ */
+class CurveSpec
+{
+public:
+    using Ptr = std::shared_ptr<const CurveSpec>;
+
+    /**
+     * @brief Create a spec that uses one of the built-in easing curves.
+     *
+     * @param type
+     * @param duration in ms
+     * @return Ptr
+     */
+    static Ptr create (Parametric::CurveType type, int duration)
+    {
+        return std::make_shared<const CurveSpec> (Parametric::getEasingFunction (type),
+                                                  nullptr, duration);
+    }
+
+    /**
+     * @brief Create a spec that uses a custom curve function.
+     *
+     * @param curve maps progress (0..1) onto curve position.
+     * @param duration in ms
+     * @return Ptr
+     */
+    static Ptr create (Parametric::CurveFn curve, int duration)
+    {
+        return std::make_shared<const CurveSpec> (nullptr, std::move (curve), duration);
+    }
+
+    CurveSpec (Parametric::EasingFn easing_, Parametric::CurveFn curve_, int duration_)
+    : easing { easing_ }
+    , curve { std::move (curve_) }
+    , duration { duration_ }
+    {
+        jassert (duration > 0);
+        jassert (easing != nullptr || curve != nullptr);
+    }
+
+    /**
+     * @param progress position in time (0..1)
+     * @return position along the curve.
+     */
+    float apply (float progress) const
+    {
+        return (easing != nullptr) ? easing (progress) : curve (progress);
+    }
+
+    /// @brief built-in curve, or nullptr if we use a custom one.
+    const Parametric::EasingFn easing;
+    /// @brief custom curve function.
+    const Parametric::CurveFn curve;
+    /// @brief duration of the curve in ms.
+    const int duration;
+};
+
+/**
+ * @class SharedCurve
+ * @brief A time-based value that follows a shared `CurveSpec`. Each
+ * instance only stores its own start and end values and an offset (in ms)
+ * before it starts moving; the easing and duration live in the spec. Unlike
+ * the other time-based values, it can't be retargeted or rendered at audio
+ * rate.
+ */
+class SharedCurve : public AnimatedValue
+{
+public:
+    /**
+     * @brief Construct a new SharedCurve.
+     *
+     * @param spec      the curve to follow.
+     * @param startVal
+     * @param endVal
+     * @param offset    ms to hold the start value before moving.
+     */
+    SharedCurve (CurveSpec::Ptr spec, float startVal, float endVal, int offset = 0);
+
+    float getNextValue (int msElapsed, int msSinceLastUpdate) override;
+
+    bool isFinished () override { return finished || canceled; }
+
+    bool canSample () const override { return true; }
+
+    float valueAt (int msElapsed) override;
+
+    int getDuration () const override { return offset + spec->duration; }
+
+    float seek (int msElapsed) override;
+
+    /**
+     * @return the curve we follow.
+     */
+    const CurveSpec::Ptr& getSpec () const { return spec; }
+
+private:
+    /**
+     * @param time ms since we started, including our offset.
+     * @return our value at that time.
+     */
+    float calculate (float time) const;
+
+private:
+    CurveSpec::Ptr spec;
+
+    /// @brief ms before we start moving.
+    int offset;
+};
+
+} // namespace friz
@@ -94,6 +94,12 @@ public:
     {
     }
 
+    /**
+     * @brief Our curve is fixed by the start and end phases, so there's no
+     * target to change.
+     */
+    bool updateTarget (float /*newTarget*/) override { return false; }
+
 private:
     /**
      * @brief Calculate the next phase value, then return its sine as the
@@ -108,6 +114,13 @@ private:
         return std::sin (phase);
     }
 
+    void generateBlock (float* values, int numValues) override
+    {
+        const auto phaseRange { endPhase - startPhase };
+        for (int i { 0 }; i < numValues; ++i)
+            values[i] = sin_f (startPhase + values[i] * phaseRange);
+    }
+
 private:
     /// @brief initial phase of the sinusoid.
     float startPhase;
@@ -71,6 +71,27 @@ float Spring::generateNextValue ()
     return next;
 }
 
+bool Spring::getIntegratorState (FixedStepIntegrator::State& state) const
+{
+    state.model    = FixedStepIntegrator::Model::spring;
+    state.rate     = acceleration;
+    state.scale    = damping;
+    state.velocity = velocity;
+    return true;
+}
+
+void Spring::setIntegratorState (const FixedStepIntegrator::State& state)
+{
+    acceleration = state.rate;
+    velocity     = state.velocity;
+}
+
+void Spring::targetChanged ()
+{
+    // keep our velocity, but accelerate toward the new end value.
+    acceleration = std::copysign (acceleration, endVal - currentVal);
+}
+
 #ifdef qRunUnitTests
 #include "test/test_Spring.cpp"
 #endif
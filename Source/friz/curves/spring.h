@@ -49,6 +49,13 @@ public:
      */
     Spring (float startVal, float endVal, float tolerance, float accel, float dampen);
 
+protected:
+    bool getIntegratorState (FixedStepIntegrator::State& state) const override;
+
+    void setIntegratorState (const FixedStepIntegrator::State& state) override;
+
+    void targetChanged () override;
+
 private:
     float generateNextValue () override;
 
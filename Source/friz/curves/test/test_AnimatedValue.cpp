@@ -0,0 +1,58 @@
+
+class Test_RenderBlock : public SubTest
+{
+public:
+   Test_RenderBlock()
+   : SubTest("renderBlock", "Values")
+   {
+
+   }
+
+   void runTest() override
+   {
+      Test("matches frame playback", [=] {
+         Parametric frames(Parametric::kEaseInOutCubic, 0.f, 100.f, 100);
+         Parametric samples(Parametric::kEaseInOutCubic, 0.f, 100.f, 100);
+
+         // at 1 kHz there's one sample per millisecond; render in odd-sized
+         // blocks to make sure each one picks up where the last one stopped.
+         std::vector<float> rendered;
+         float block[7];
+         while (rendered.size() < 100)
+         {
+            const int left = 100 - static_cast<int>(rendered.size());
+            expectEquals(samples.renderBlock(block, 7, 1000.0), std::min(7, left));
+            rendered.insert(rendered.end(), block, block + 7);
+         }
+
+         for (int ms = 0; ms < 100; ++ms)
+         {
+            expectWithinAbsoluteError<float>(rendered[ms], frames.getNextValue(ms, 1), 0.001f);
+         }
+      });
+
+      Test("ends on the end value", [=] {
+         Linear val(0.f, 100.f, 10);
+         float block[48 * 8];
+
+         // 10 ms at 48 kHz is 480 samples.
+         expectEquals(val.renderBlock(block, 48 * 8, 48000.0), 48 * 8);
+         expectWithinAbsoluteError<float>(block[48 * 5], 50.f, 0.001f);
+         expect(! val.isFinished());
+
+         expectEquals(val.renderBlock(block, 48 * 8, 48000.0), 96);
+         expect(val.isFinished());
+         expectWithinAbsoluteError<float>(block[95], 100.f * 479 / 480, 0.001f);
+         expectWithinAbsoluteError<float>(block[96], 100.f, 0.001f);
+         expectWithinAbsoluteError<float>(block[48 * 8 - 1], 100.f, 0.001f);
+
+         // ...and starts again when asked.
+         val.resetBlockPosition();
+         expectEquals(val.renderBlock(block, 1, 48000.0), 1);
+         expectWithinAbsoluteError<float>(block[0], 0.f, 0.001f);
+      });
+   }
+
+};
+
+static Test_RenderBlock   testRenderBlock;
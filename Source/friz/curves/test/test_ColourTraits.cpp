@@ -0,0 +1,116 @@
+
+class Test_ColourTraits : public SubTest
+{
+public:
+   Test_ColourTraits()
+   : SubTest("ColourTraits", "Values")
+   {
+
+   }
+
+   void runTest() override
+   {
+      Test("sRGB to OKLab and back", [=] {
+         for (juce::uint32 r = 0; r < 256; r += 15)
+         {
+            for (juce::uint32 g = 0; g < 256; g += 15)
+            {
+               for (juce::uint32 b = 0; b < 256; b += 15)
+               {
+                  const juce::uint32 argb = 0xff000000 | (r << 16) | (g << 8) | b;
+                  const auto lanes = OklabColourTraits::toLanes(juce::Colour(argb));
+                  expectEquals(OklabColourTraits::toARGB(lanes), argb);
+                  const juce::Colour colour(argb);
+                  expectEquals(OklchColourTraits::toARGB(OklchColourTraits::toLanes(colour)), argb);
+                  using LinearTraits = LinearRgbColourTraits;
+                  expectEquals(LinearTraits::toARGB(LinearTraits::toLanes(colour)), argb);
+               }
+            }
+         }
+
+         // OKLab's white is L = 1 with no colour.
+         const auto white = colour::linearToOklab(1.f, 1.f, 1.f);
+         expectWithinAbsoluteError<float>(white[0], 1.f, 0.001f);
+         expectWithinAbsoluteError<float>(white[1], 0.f, 0.001f);
+         expectWithinAbsoluteError<float>(white[2], 0.f, 0.001f);
+      });
+
+      Test("premultiplied alpha", [=] {
+         // a transparent colour has nothing left but its alpha...
+         const auto clear = OklabColourTraits::toLanes(juce::Colour(0x00ff4020u));
+         for (auto lane : clear)
+            expectWithinAbsoluteError<float>(lane, 0.f, 0.0001f);
+         expectEquals(OklabColourTraits::toARGB(clear), juce::uint32 { 0 });
+
+         // ...so fading in from it doesn't pick up its colour on the way.
+         auto from = LinearRgbColourTraits::toLanes(juce::Colour(0x00ff0000u));
+         auto to = LinearRgbColourTraits::toLanes(juce::Colour(0xff0000ffu));
+         LinearRgbColourTraits::Lanes middle;
+         for (size_t i = 0; i < middle.size(); ++i)
+            middle[i] = (from[i] + to[i]) / 2.f;
+         expectEquals(LinearRgbColourTraits::toARGB(middle), juce::uint32 { 0x800000ff });
+
+         // partly transparent colours survive the round trip.
+         const juce::uint32 argb = 0x80ff4020;
+         expectEquals(OklabColourTraits::toARGB(OklabColourTraits::toLanes(juce::Colour(argb))),
+                      argb);
+      });
+
+      Test("hue wraps around", [=] {
+         constexpr auto pi = juce::MathConstants<float>::pi;
+
+         // from just below +pi to just above -pi is a short step, not almost a full turn.
+         OklchColourTraits::Lanes from { 0.5f, 0.1f, 3.f, 1.f };
+         OklchColourTraits::Lanes to { 0.5f, 0.1f, -3.f, 1.f };
+         OklchColourTraits::prepare(from, to);
+         expectWithinAbsoluteError<float>(to[2] - from[2], 2.f * pi - 6.f, 0.0001f);
+
+         OklchColourTraits::Lanes back { 0.5f, 0.1f, 3.f, 1.f };
+         OklchColourTraits::Lanes start { 0.5f, 0.1f, -3.f, 1.f };
+         OklchColourTraits::prepare(start, back);
+         expectWithinAbsoluteError<float>(back[2] - start[2], 6.f - 2.f * pi, 0.0001f);
+
+         // a grey takes the hue of the colour it's moving to.
+         OklchColourTraits::Lanes grey { 0.5f, 0.f, 0.f, 1.f };
+         OklchColourTraits::Lanes red { 0.6f, 0.2f, 0.5f, 1.f };
+         OklchColourTraits::prepare(grey, red);
+         expectWithinAbsoluteError<float>(grey[2], 0.5f, 0.0001f);
+         expectWithinAbsoluteError<float>(red[2], 0.5f, 0.0001f);
+      });
+
+      Test("batch conversion", [=] {
+         const juce::uint32 colours[] { 0xffff0000, 0x80204060, 0x00000000, 0xff7f7f7f,
+                                        0x40ffffff };
+         constexpr int kCount = 5;
+
+         auto check = [&] (auto traits) {
+            using Traits = decltype(traits);
+            std::array<std::array<float, kCount>, 4> lanes;
+            for (int i = 0; i < kCount; ++i)
+            {
+               const auto colourLanes = Traits::toLanes(juce::Colour(colours[i]));
+               for (size_t lane = 0; lane < 4; ++lane)
+                  lanes[lane][i] = colourLanes[lane];
+            }
+
+            const float* lanePtrs[] { lanes[0].data(), lanes[1].data(), lanes[2].data(),
+                                      lanes[3].data() };
+            juce::uint32 dest[kCount];
+            Traits::toARGB(lanePtrs, dest, kCount);
+            for (int i = 0; i < kCount; ++i)
+            {
+               const typename Traits::Lanes single { lanes[0][i], lanes[1][i], lanes[2][i],
+                                                     lanes[3][i] };
+               expectEquals(dest[i], Traits::toARGB(single));
+            }
+         };
+
+         check(LinearRgbColourTraits {});
+         check(OklabColourTraits {});
+         check(OklchColourTraits {});
+      });
+   }
+
+};
+
+static Test_ColourTraits   testColourTraits;
@@ -0,0 +1,81 @@
+
+class Test_CubicBezier : public SubTest
+{
+public:
+   Test_CubicBezier() 
+   : SubTest("CubicBezier", "Values")
+   {
+
+   }
+
+   void runTest() override
+   {
+      Test("matches known curves", [=] {
+         // cubic-bezier(0, 0, 1, 1) is linear
+         CubicBezier linear(0.f, 100.f, 100, 0.f, 0.f, 1.f, 1.f);
+         expectWithinAbsoluteError<float>(linear.valueAt(25), 25.f, 0.01f);
+
+         // CSS 'ease-in-out' is symmetric around its midpoint.
+         CubicBezier easeInOut(0.f, 1.f, 100, 0.42f, 0.f, 0.58f, 1.f);
+         expectWithinAbsoluteError<float>(easeInOut.valueAt(50), 0.5f, 0.001f);
+         expectWithinAbsoluteError<float>(easeInOut.valueAt(20) + easeInOut.valueAt(80), 1.f,
+                                          0.001f);
+         expectWithinAbsoluteError<float>(easeInOut.valueAt(100), 1.f, 0.001f);
+      });
+
+      Test("solvers are shared", [=] {
+         auto first = CubicBezier::getSolver(0.25f, 0.1f, 0.25f, 1.f);
+         auto second = CubicBezier::getSolver(0.25f, 0.1f, 0.25f, 1.f);
+         expect(first == second);
+      });
+   }
+
+};
+
+static Test_CubicBezier   testCubicBezier;
+
+#ifdef qRunBenchmarks
+/**
+ * Timing comparisons, not correctness tests; only built when `qRunBenchmarks`
+ * is defined, and kept in their own category so they can be run separately.
+ */
+class Bench_CubicBezier : public SubTest
+{
+public:
+   Bench_CubicBezier()
+   : SubTest("CubicBezier benchmark", "Benchmarks")
+   {
+
+   }
+
+   void runTest() override
+   {
+      Test("benchmark", [=] {
+         constexpr int kIterations { 1000000 };
+         float sum { 0.f };
+
+         auto time = [&] (AnimatedValue& value) {
+            const auto start = juce::Time::getHighResolutionTicks();
+            for (int i = 0; i < kIterations; ++i)
+               sum += value.valueAt(i % 1000);
+            return juce::Time::highResolutionTicksToSeconds(
+               juce::Time::getHighResolutionTicks() - start);
+         };
+
+         CubicBezier bezier(0.f, 1.f, 1000, 0.42f, 0.f, 0.58f, 1.f);
+         Parametric parametric(0.f, 1.f, 1000, Parametric::kEaseInOutCubic);
+         Parametric custom(0.f, 1.f, 1000, Parametric::kLinear);
+         custom.SetCurve([solver = CubicBezier::getSolver(0.42f, 0.f, 0.58f, 1.f)] (float x) 
+                         { return solver->solve(x); });
+
+         logMessage("CubicBezier:            " + juce::String(time(bezier), 4) + " s");
+         logMessage("Parametric (cubic):     " + juce::String(time(parametric), 4) + " s");
+         logMessage("Parametric (SetCurve):  " + juce::String(time(custom), 4) + " s");
+         expect(sum > 0.f);
+      });
+   }
+
+};
+
+static Bench_CubicBezier   benchCubicBezier;
+#endif
@@ -75,3 +75,74 @@ public:
 };
 
 static Test_EaseIn   testEaseIn;
+
+class Test_TargetMailbox : public SubTest
+{
+public:
+   Test_TargetMailbox()
+   : SubTest("TargetMailbox", "Values")
+   {
+
+   }
+
+   void runTest() override
+   {
+      Test("coalesces to the latest target", [=] {
+         TargetMailbox mailbox;
+         float target = -1.f;
+         expect(! mailbox.collect(target));
+
+         for (float posted : { 1.f, -2.5f, 0.f })
+            mailbox.post(posted);
+
+         // only the last one posted, and only once.
+         expect(mailbox.collect(target));
+         expectEquals(target, 0.f);
+         expect(! mailbox.collect(target));
+      });
+
+      Test("feeds a SmoothedValue", [=] {
+         SmoothedValue fed(0.f, 100.f, 0.01f, 0.5f);
+         SmoothedValue direct(0.f, 100.f, 0.01f, 0.5f);
+         auto mailbox = fed.getTargetMailbox();
+         expect(mailbox == fed.getTargetMailbox());
+
+         fed.getNextValue(0, 0);
+         direct.getNextValue(0, 0);
+         mailbox->post(10.f);
+         mailbox->post(-20.f);
+         direct.updateTarget(-20.f);
+
+         for (int ms = 10; ms < 100; ms += 10)
+            expectWithinAbsoluteError<float>(fed.getNextValue(ms, 10), direct.getNextValue(ms, 10),
+                                             0.0001f);
+         expectWithinAbsoluteError<float>(fed.getEndValue(), -20.f, 0.0001f);
+      });
+
+      Test("posts from another thread", [=] {
+         TargetMailbox mailbox;
+         constexpr int kCount = 100000;
+         std::thread producer([&mailbox] {
+            for (int i = 1; i <= kCount; ++i)
+               mailbox.post(static_cast<float>(i));
+         });
+
+         // we may miss some, but never go backward.
+         float last = 0.f;
+         float target;
+         while (last < kCount)
+         {
+            if (mailbox.collect(target))
+            {
+               expect(target > last);
+               last = target;
+            }
+         }
+         producer.join();
+         expectEquals(last, static_cast<float>(kCount));
+      });
+   }
+
+};
+
+static Test_TargetMailbox   testTargetMailbox;
@@ -0,0 +1,51 @@
+
+class Test_Keyframe : public SubTest
+{
+public:
+   Test_Keyframe() 
+   : SubTest("Keyframe", "Values")
+   {
+
+   }
+
+   void runTest() override
+   {
+      Test("playback", [=] {
+         KeyframeValue val({ { 0, 0.f }, { 100, 100.f }, { 200, 50.f } });
+         expectEquals(val.getDuration(), 200);
+
+         expectWithinAbsoluteError<float>(val.getNextValue(0, 0), 0.f, 0.01f);
+         expectWithinAbsoluteError<float>(val.getNextValue(50, 50), 50.f, 0.01f);
+         expectWithinAbsoluteError<float>(val.getNextValue(150, 100), 75.f, 0.01f);
+         expect(! val.isFinished());
+         expectWithinAbsoluteError<float>(val.getNextValue(200, 50), 50.f, 0.01f);
+         expect(val.isFinished());
+      });
+
+      Test("seeking", [=] {
+         KeyframeValue val({ { 200, 50.f }, { 0, 0.f }, { 100, 100.f } });
+
+         // keys are sorted, and random access matches playback.
+         expectWithinAbsoluteError<float>(val.seek(150), 75.f, 0.01f);
+         expectWithinAbsoluteError<float>(val.seek(25), 25.f, 0.01f);
+         expectWithinAbsoluteError<float>(val.seek(175), 62.5f, 0.01f);
+         expect(! val.isFinished());
+      });
+
+      Test("easing and holds", [=] {
+         KeyframeValue val({ { 100, 0.f }, 
+                             { 200, 100.f, Parametric::getEasingFunction(Parametric::kEaseInQuad) },
+                             { 200, 10.f } });
+
+         // hold the first value until its key.
+         expectWithinAbsoluteError<float>(val.valueAt(50), 0.f, 0.01f);
+         expectWithinAbsoluteError<float>(val.valueAt(150), 25.f, 0.01f);
+         // two keys at the same time make a jump.
+         expectWithinAbsoluteError<float>(val.valueAt(199), 98.01f, 0.01f);
+         expectWithinAbsoluteError<float>(val.valueAt(200), 10.f, 0.01f);
+      });
+   }
+
+};
+
+static Test_Keyframe   testKeyframe;
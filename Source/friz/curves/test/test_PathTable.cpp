@@ -0,0 +1,83 @@
+
+class Test_PathTable : public SubTest
+{
+public:
+   Test_PathTable()
+   : SubTest("PathTable", "Values")
+   {
+
+   }
+
+   void runTest() override
+   {
+      Test("arc length lookup", [=] {
+         juce::Path path;
+         path.startNewSubPath(0.f, 0.f);
+         path.lineTo(100.f, 0.f);
+         path.lineTo(100.f, 50.f);
+         auto table = PathTable::create(path);
+
+         expectWithinAbsoluteError<float>(table->getLength(), 150.f, 0.001f);
+         expect(table->getPoint(50.f).getDistanceFrom({ 50.f, 0.f }) < 0.001f);
+         expect(table->getPoint(125.f).getDistanceFrom({ 100.f, 25.f }) < 0.001f);
+
+         // distances are clamped to the path.
+         expect(table->getPoint(-10.f).getDistanceFrom({ 0.f, 0.f }) < 0.001f);
+         expect(table->getPoint(500.f).getDistanceFrom({ 100.f, 50.f }) < 0.001f);
+
+         // angles are clockwise from the x axis (y points down).
+         expectWithinAbsoluteError<float>(table->getPosition(10.f).angle, 0.f, 0.001f);
+         expectWithinAbsoluteError<float>(table->getPosition(125.f).angle,
+                                          juce::MathConstants<float>::halfPi, 0.001f);
+      });
+
+      Test("jumps between sub-paths", [=] {
+         juce::Path path;
+         path.startNewSubPath(0.f, 0.f);
+         path.lineTo(10.f, 0.f);
+         path.startNewSubPath(100.f, 100.f);
+         path.lineTo(110.f, 100.f);
+         auto table = PathTable::create(path);
+
+         // the jump doesn't add to the length.
+         expectWithinAbsoluteError<float>(table->getLength(), 20.f, 0.001f);
+         expect(table->getPoint(15.f).getDistanceFrom({ 105.f, 100.f }) < 0.001f);
+      });
+
+      Test("Catmull-Rom passes through its points", [=] {
+         const std::vector<juce::Point<float>> points { { 0.f, 0.f }, { 50.f, 80.f },
+                                                        { 120.f, 20.f }, { 200.f, 60.f } };
+         for (bool closed : { false, true })
+         {
+            auto table = PathTable::createCatmullRom(points, closed);
+            expect(table->getPoint(0.f).getDistanceFrom(points.front()) < 0.001f);
+            const auto end = closed ? points.front() : points.back();
+            expect(table->getPoint(table->getLength()).getDistanceFrom(end) < 0.001f);
+
+            // every point is on the curve, in order.
+            float distance = 0.f;
+            for (const auto& point : points)
+            {
+               float nearest = std::numeric_limits<float>::max();
+               for (float d = distance; d <= table->getLength(); d += 0.25f)
+               {
+                  const auto gap = table->getPoint(d).getDistanceFrom(point);
+                  if (gap < nearest)
+                  {
+                     nearest = gap;
+                     distance = d;
+                  }
+               }
+               expect(nearest < 0.5f);
+            }
+         }
+
+         // evenly spaced points in a line make a straight line.
+         auto line = PathTable::createCatmullRom({ { 0.f, 0.f }, { 10.f, 0.f }, { 20.f, 0.f } });
+         expectWithinAbsoluteError<float>(line->getLength(), 20.f, 0.01f);
+      });
+   }
+
+};
+
+static Test_PathTable   testPathTable;
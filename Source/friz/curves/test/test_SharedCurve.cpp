@@ -0,0 +1,60 @@
+
+class Test_SharedCurve : public SubTest
+{
+public:
+   Test_SharedCurve()
+   : SubTest("SharedCurve", "Values")
+   {
+
+   }
+
+   void runTest() override
+   {
+      Test("matches Parametric", [=] {
+         auto spec = CurveSpec::create(Parametric::kEaseOutQuad, 100);
+         SharedCurve shared(spec, 10.f, -30.f);
+         Parametric parametric(Parametric::kEaseOutQuad, 10.f, -30.f, 100);
+
+         for (int ms = 0; ms <= 100; ms += 5)
+         {
+            expectWithinAbsoluteError<float>(shared.getNextValue(ms, 5),
+                                             parametric.getNextValue(ms, 5), 0.001f);
+         }
+         expect(shared.isFinished());
+      });
+
+      Test("offset and sharing", [=] {
+         auto spec = CurveSpec::create([](float progress) { return progress * progress; }, 50);
+         SharedCurve first(spec, 0.f, 100.f);
+         SharedCurve second(spec, 0.f, 100.f, 20);
+         expect(spec.use_count() == 3);
+         expectEquals(second.getDuration(), 70);
+
+         // the second curve holds its start value through its offset.
+         expectWithinAbsoluteError<float>(second.valueAt(20), 0.f, 0.001f);
+         expectWithinAbsoluteError<float>(first.valueAt(25), 25.f, 0.001f);
+         expectWithinAbsoluteError<float>(second.valueAt(45), 25.f, 0.001f);
+         expectWithinAbsoluteError<float>(second.valueAt(70), 100.f, 0.001f);
+      });
+
+      Test("cancel", [=] {
+         auto spec = CurveSpec::create(Parametric::kLinear, 100);
+         SharedCurve val(spec, 0.f, 100.f);
+         expectWithinAbsoluteError<float>(val.getNextValue(30, 30), 30.f, 0.001f);
+
+         // stays where it was canceled.
+         val.cancel(false);
+         expect(val.isFinished());
+         expectWithinAbsoluteError<float>(val.getNextValue(60, 30), 30.f, 0.001f);
+
+         SharedCurve other(spec, 0.f, 100.f);
+         other.getNextValue(30, 30);
+         other.cancel(true);
+         expect(other.isFinished());
+         expectWithinAbsoluteError<float>(other.getNextValue(60, 30), 100.f, 0.001f);
+      });
+   }
+
+};
+
+static Test_SharedCurve   testSharedCurve;
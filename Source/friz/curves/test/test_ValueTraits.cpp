@@ -0,0 +1,96 @@
+class Test_ValueTraits : public SubTest
+{
+public:
+   Test_ValueTraits() 
+   : SubTest("ValueTraits", "Values")
+   {
+
+   }
+
+   template <typename Traits>
+   void expectLanes(const typename Traits::Lanes& lanes, const typename Traits::Lanes& expected,
+                    float tolerance)
+   {
+      for (size_t i = 0; i < Traits::laneCount; ++i)
+         expectWithinAbsoluteError<float>(lanes[i], expected[i], tolerance);
+   }
+
+   void expectTransform(const juce::AffineTransform& t, const juce::AffineTransform& expected)
+   {
+      expectWithinAbsoluteError<float>(t.mat00, expected.mat00, 0.0001f);
+      expectWithinAbsoluteError<float>(t.mat01, expected.mat01, 0.0001f);
+      expectWithinAbsoluteError<float>(t.mat02, expected.mat02, 0.0001f);
+      expectWithinAbsoluteError<float>(t.mat10, expected.mat10, 0.0001f);
+      expectWithinAbsoluteError<float>(t.mat11, expected.mat11, 0.0001f);
+      expectWithinAbsoluteError<float>(t.mat12, expected.mat12, 0.0001f);
+   }
+
+   void runTest() override
+   {
+      Test("points and rectangles", [=] {
+         using PointTraits = ValueTraits<juce::Point<float>>;
+         const juce::Point<float> pt { 3.5f, -7.f };
+         expectLanes<PointTraits>(PointTraits::toLanes(pt), { 3.5f, -7.f }, 0.f);
+         expect(PointTraits::fromLanes(PointTraits::toLanes(pt)) == pt);
+
+         using RectTraits = ValueTraits<juce::Rectangle<float>>;
+         const juce::Rectangle<float> rect { 10.f, 20.f, 300.f, 40.5f };
+         expectLanes<RectTraits>(RectTraits::toLanes(rect), { 10.f, 20.f, 300.f, 40.5f }, 0.f);
+         expect(RectTraits::fromLanes(RectTraits::toLanes(rect)) == rect);
+      });
+
+      Test("colours", [=] {
+         using ColourTraits = ValueTraits<juce::Colour>;
+         const juce::Colour colour { 0x80ff4020 };
+         expectLanes<ColourTraits>(ColourTraits::toLanes(colour), 
+                                   { 1.f, 64.f / 255.f, 32.f / 255.f, 128.f / 255.f }, 0.0001f);
+         expectEquals(ColourTraits::fromLanes(ColourTraits::toLanes(colour)).getARGB(),
+                      colour.getARGB());
+      });
+
+      Test("transform round trip", [=] {
+         using TransformTraits = ValueTraits<juce::AffineTransform>;
+         const auto t { juce::AffineTransform::shear(0.25f, 0.f)
+                           .scaled(2.f, 3.f)
+                           .rotated(0.5f)
+                           .translated(10.f, 20.f) };
+         expectTransform(TransformTraits::fromLanes(TransformTraits::toLanes(t)), t);
+
+         // {tx, ty, rotation, scale x, scale y, shear}
+         const auto lanes { TransformTraits::toLanes(juce::AffineTransform::scale(2.f, 3.f)
+                                                        .rotated(0.5f)
+                                                        .translated(10.f, 20.f)) };
+         expectLanes<TransformTraits>(lanes, { 10.f, 20.f, 0.5f, 2.f, 3.f, 0.f }, 0.0001f);
+
+         // a flipped transform comes back, too.
+         const auto flipped { juce::AffineTransform::scale(-1.f, 2.f).rotated(2.f) };
+         expectTransform(TransformTraits::fromLanes(TransformTraits::toLanes(flipped)), flipped);
+      });
+
+      Test("transform interpolation", [=] {
+         using TransformTraits = ValueTraits<juce::AffineTransform>;
+         constexpr auto pi { juce::MathConstants<float>::pi };
+
+         // halfway through a quarter turn, the shape hasn't shrunk.
+         auto from { TransformTraits::toLanes(juce::AffineTransform::scale(2.f, 2.f)) };
+         auto to { TransformTraits::toLanes(
+            juce::AffineTransform::scale(2.f, 2.f).rotated(pi / 2.f)) };
+         prepareLanes<TransformTraits>(from, to);
+         TransformTraits::Lanes mid;
+         for (size_t i = 0; i < TransformTraits::laneCount; ++i)
+            mid[i] = (from[i] + to[i]) / 2.f;
+         expectTransform(TransformTraits::fromLanes(mid), 
+                         juce::AffineTransform::scale(2.f, 2.f).rotated(pi / 4.f));
+
+         // rotation takes the short way around, through 180 degrees.
+         from = TransformTraits::toLanes(juce::AffineTransform::rotation(0.9f * pi));
+         to = TransformTraits::toLanes(juce::AffineTransform::rotation(-0.9f * pi));
+         prepareLanes<TransformTraits>(from, to);
+         expectWithinAbsoluteError<float>(to[2] - from[2], 0.2f * pi, 0.0001f);
+         expectWithinAbsoluteError<float>((from[2] + to[2]) / 2.f, pi, 0.0001f);
+      });
+   }
+
+};
+
+static Test_ValueTraits   testValueTraits;
@@ -0,0 +1,112 @@
+/*
+    Copyright (c) 2019-2023 Brett g Porter
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "track.h"
+
+namespace friz
+{
+
+bool TrackValue::addSegment (std::unique_ptr<AnimatedValue> value, int startTime,
+                             int endTime)
+{
+    const auto previousEnd { segments.empty () ? 0 : segments.back ().endTime };
+    if (value == nullptr || !value->canSample () || startTime < previousEnd ||
+        endTime < startTime)
+    {
+        jassertfalse;
+        return false;
+    }
+
+    const auto startValue { value->valueAt (0) };
+    const auto endValue { value->valueAt (endTime - startTime) };
+    segments.push_back ({ startTime, endTime, startValue, endValue, std::move (value) });
+
+    if (segments.size () == 1)
+        startVal = currentVal = startValue;
+    endVal   = endValue;
+    duration = endTime;
+    return true;
+}
+
+float TrackValue::getNextValue (int msElapsed, int msSinceLastUpdate)
+{
+    TimedValue::getNextValue (msElapsed, msSinceLastUpdate);
+
+    if (releaseFinished)
+    {
+        // everything before the segment we're in is done with.
+        const auto doneCount { finished ? segments.size () : cursor };
+        for (size_t i { 0 }; i < doneCount; ++i)
+            segments[i].value.reset ();
+    }
+
+    return currentVal;
+}
+
+float TrackValue::valueAt (int msElapsed)
+{
+    if (msElapsed >= duration || segments.empty ())
+        return endVal;
+
+    const auto& segment { segments[findSegment (msElapsed)] };
+    if (msElapsed < segment.startTime)
+        return segment.startValue;
+    if (msElapsed >= segment.endTime)
+        return segment.endValue;
+
+    if (segment.value == nullptr)
+    {
+        // this segment was released; see setReleaseFinished()
+        jassertfalse;
+        return segment.endValue;
+    }
+
+    return segment.value->valueAt (msElapsed - segment.startTime);
+}
+
+float TrackValue::generateNextValue (float progress)
+{
+    return valueAt (juce::roundToInt (progress * duration));
+}
+
+size_t TrackValue::findSegment (int msElapsed)
+{
+    // during playback, we're usually in the same segment as last time or
+    // the one after it.
+    if (segments[cursor].startTime <= msElapsed)
+    {
+        if (cursor + 1 == segments.size () || msElapsed < segments[cursor + 1].startTime)
+            return cursor;
+        if (cursor + 2 == segments.size () || msElapsed < segments[cursor + 2].startTime)
+            return ++cursor;
+    }
+
+    const auto it { std::upper_bound (segments.begin (), segments.end (), msElapsed,
+                                      [] (int time, const Segment& segment)
+                                      { return time < segment.startTime; }) };
+    cursor = (it == segments.begin ())
+                 ? 0
+                 : static_cast<size_t> (std::distance (segments.begin (), it)) - 1;
+    return cursor;
+}
+
+} // namespace friz
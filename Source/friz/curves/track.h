@@ -0,0 +1,113 @@
+/*
+    Copyright (c) 2019-2023 Brett g Porter
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#pragma once
+
+#include "animatedValue.h"
+
+namespace friz
+{
+/**
+ * @class TrackValue
+ * @brief A time-based value made by laying other time-based values out end
+ * to end on a single track, with the boundaries between them calculated in
+ * advance. This is what a `Sequence` becomes when it's compiled.
+ *
+ * Between segments (and before the first one) we hold the nearest value. As
+ * we play forward, segments that are finished can be released immediately.
+ */
+class TrackValue : public TimedValue
+{
+public:
+    TrackValue ()
+    : TimedValue (0.f, 0.f, 0)
+    {
+    }
+
+    /**
+     * @brief Add a value to the end of the track.
+     *
+     * @param value     value to run; must support sampling.
+     * @param startTime time (in ms from the start of the track) that this segment
+     *                  begins; no earlier than the end of the previous segment.
+     * @param endTime   time that this segment ends; we hold the value's end value
+     *                  from the end of its own duration until then.
+     * @return false if the value or times can't be used.
+     */
+    bool addSegment (std::unique_ptr<AnimatedValue> value, int startTime, int endTime);
+
+    /**
+     * @brief Release each segment's value object as soon as we've played past
+     * it (on by default). Released segments can't be sampled or sought again,
+     * so turn this off if you need to go backward.
+     *
+     * @param shouldRelease
+     */
+    void setReleaseFinished (bool shouldRelease) { releaseFinished = shouldRelease; }
+
+    float getNextValue (int msElapsed, int msSinceLastUpdate) override;
+
+    bool canSample () const override { return !releaseFinished; }
+
+    float valueAt (int msElapsed) override;
+
+    /**
+     * @brief Retarget the segments themselves; the track can't be.
+     */
+    bool updateTarget (float /*newTarget*/) override { return false; }
+
+    /**
+     * @return the number of segments on the track.
+     */
+    size_t getSegmentCount () const { return segments.size (); }
+
+private:
+    float generateNextValue (float progress) override;
+
+    /**
+     * @brief Find the last segment that starts at or before a point in time.
+     *
+     * @param msElapsed
+     * @return index of the segment, or 0 if we're before the first one.
+     */
+    size_t findSegment (int msElapsed);
+
+private:
+    struct Segment
+    {
+        int startTime;
+        int endTime;
+        float startValue;
+        float endValue;
+        std::unique_ptr<AnimatedValue> value;
+    };
+
+    std::vector<Segment> segments;
+
+    /// @brief index of the segment we were last in.
+    size_t cursor { 0 };
+
+    /// @brief release segments once we're past them?
+    bool releaseFinished { true };
+};
+
+} // namespace friz
@@ -0,0 +1,72 @@
+/*
+    Copyright (c) 2019-2023 Brett g Porter
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "valueTraits.h"
+
+namespace friz
+{
+
+// The linear part of the matrix is treated as a rotation applied after an
+// upper-triangular scale/shear: [a b; c d] = R(angle) * [sx shear; 0 sy].
+
+ValueTraits<juce::AffineTransform>::Lanes
+ValueTraits<juce::AffineTransform>::toLanes (const juce::AffineTransform& t)
+{
+    const auto angle { std::atan2 (t.mat10, t.mat00) };
+    const auto cosA { std::cos (angle) };
+    const auto sinA { std::sin (angle) };
+
+    const auto scaleX { std::hypot (t.mat00, t.mat10) };
+    const auto shear { t.mat01 * cosA + t.mat11 * sinA };
+    const auto scaleY { t.mat11 * cosA - t.mat01 * sinA };
+
+    return { t.mat02, t.mat12, angle, scaleX, scaleY, shear };
+}
+
+juce::AffineTransform ValueTraits<juce::AffineTransform>::fromLanes (const Lanes& lanes)
+{
+    const auto cosA { std::cos (lanes[2]) };
+    const auto sinA { std::sin (lanes[2]) };
+    const auto scaleX { lanes[3] };
+    const auto scaleY { lanes[4] };
+    const auto shear { lanes[5] };
+
+    return { scaleX * cosA, shear * cosA - scaleY * sinA, lanes[0],
+             scaleX * sinA, shear * sinA + scaleY * cosA, lanes[1] };
+}
+
+void ValueTraits<juce::AffineTransform>::prepare (Lanes& from, Lanes& to)
+{
+    const auto twoPi { juce::MathConstants<float>::twoPi };
+    const auto pi { juce::MathConstants<float>::pi };
+
+    while (to[2] - from[2] > pi)
+        to[2] -= twoPi;
+    while (to[2] - from[2] < -pi)
+        to[2] += twoPi;
+}
+
+#ifdef qRunUnitTests
+#include "test/test_ValueTraits.cpp"
+#endif
+
+} // namespace friz
@@ -0,0 +1,155 @@
+/*
+    Copyright (c) 2019-2023 Brett g Porter
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <array>
+
+namespace friz
+{
+
+/**
+ * @struct ValueTraits
+ * @brief Describes how to convert a value of some type into a contiguous set of
+ * floating point 'lanes' that can be animated together, and back again.
+ *
+ * Specializations must provide:
+ * - `laneCount`, the number of floats needed to represent a value
+ * - `toLanes()`, to split a value into its lanes
+ * - `fromLanes()`, to rebuild a value from its (interpolated) lanes.
+ *
+ * and may optionally provide
+ * - `prepare (Lanes& from, Lanes& to)`, to adjust the start and end lanes
+ *   before animating between them (e.g. to go the short way around a circle)
+ *
+ * Specialize this template to animate your own types with `TypedAnimation`, or
+ * pass another struct with the same members as its `Traits` argument.
+ */
+template <typename T> struct ValueTraits;
+
+namespace detail
+{
+template <typename Traits, typename = void> struct HasPrepare : std::false_type
+{
+};
+
+template <typename Traits>
+struct HasPrepare<Traits,
+                  std::void_t<decltype (Traits::prepare (
+                      std::declval<typename Traits::Lanes&> (),
+                      std::declval<typename Traits::Lanes&> ()))>> : std::true_type
+{
+};
+} // namespace detail
+
+/**
+ * @brief Call `Traits::prepare()` on a pair of start and end lanes, if the
+ * traits class has one.
+ */
+template <typename Traits>
+void prepareLanes (typename Traits::Lanes& from, typename Traits::Lanes& to)
+{
+    if constexpr (detail::HasPrepare<Traits>::value)
+        Traits::prepare (from, to);
+}
+
+template <> struct ValueTraits<float>
+{
+    static constexpr std::size_t laneCount { 1 };
+    using Lanes = std::array<float, laneCount>;
+
+    static Lanes toLanes (float value) { return { value }; }
+    static float fromLanes (const Lanes& lanes) { return lanes[0]; }
+};
+
+template <> struct ValueTraits<juce::Point<float>>
+{
+    static constexpr std::size_t laneCount { 2 };
+    using Lanes = std::array<float, laneCount>;
+
+    static Lanes toLanes (const juce::Point<float>& pt) { return { pt.x, pt.y }; }
+
+    static juce::Point<float> fromLanes (const Lanes& lanes)
+    {
+        return { lanes[0], lanes[1] };
+    }
+};
+
+template <> struct ValueTraits<juce::Rectangle<float>>
+{
+    static constexpr std::size_t laneCount { 4 };
+    using Lanes = std::array<float, laneCount>;
+
+    static Lanes toLanes (const juce::Rectangle<float>& rect)
+    {
+        return { rect.getX (), rect.getY (), rect.getWidth (), rect.getHeight () };
+    }
+
+    static juce::Rectangle<float> fromLanes (const Lanes& lanes)
+    {
+        return { lanes[0], lanes[1], lanes[2], lanes[3] };
+    }
+};
+
+/**
+ * @brief Colours are interpolated as straight RGBA components. See
+ * colourTraits.h for traits that interpolate in other colour spaces.
+ */
+template <> struct ValueTraits<juce::Colour>
+{
+    static constexpr std::size_t laneCount { 4 };
+    using Lanes = std::array<float, laneCount>;
+
+    static Lanes toLanes (const juce::Colour& colour)
+    {
+        return { colour.getFloatRed (), colour.getFloatGreen (), colour.getFloatBlue (),
+                 colour.getFloatAlpha () };
+    }
+
+    static juce::Colour fromLanes (const Lanes& lanes)
+    {
+        return juce::Colour::fromFloatRGBA (lanes[0], lanes[1], lanes[2], lanes[3]);
+    }
+};
+
+/**
+ * @brief Transforms are split into translation, rotation, scale and shear,
+ * which are interpolated separately, so a rotating shape keeps its size
+ * and shape on the way (interpolating the matrix directly would shrink it
+ * partway through.) Rotation takes the short way around.
+ */
+template <> struct ValueTraits<juce::AffineTransform>
+{
+    static constexpr std::size_t laneCount { 6 };
+    /// translate x, translate y, rotation (radians), scale x, scale y, shear.
+    using Lanes = std::array<float, laneCount>;
+
+    static Lanes toLanes (const juce::AffineTransform& t);
+
+    static juce::AffineTransform fromLanes (const Lanes& lanes);
+
+    static void prepare (Lanes& from, Lanes& to);
+};
+
+} // namespace friz
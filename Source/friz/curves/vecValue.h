@@ -0,0 +1,237 @@
+/*
+    Copyright (c) 2019-2023 Brett g Porter
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#pragma once
+
+#include "parametric.h"
+
+namespace friz
+{
+
+/**
+ * @class VecValue
+ * @brief A time-based value with several lanes (e.g. the x, y, width and height
+ * of a rectangle) that all follow the same easing curve over the same duration.
+ *
+ * Unlike a set of separate `AnimatedValue` objects, the lanes are stored
+ * contiguously and the progress and curve position are calculated only once per
+ * frame; the per-lane interpolation is a simple loop over contiguous arrays that
+ * the compiler can vectorize.
+ *
+ * @tparam LaneCount number of floats in the value.
+ */
+template <std::size_t LaneCount> class VecValue
+{
+public:
+    using Lanes = std::array<float, LaneCount>;
+
+    /**
+     * @brief Construct a new multi-lane value.
+     *
+     * @param startVals_ initial values
+     * @param endVals_   ending values
+     * @param duration_  duration in ms.
+     * @param easing_    easing curve shared by all lanes.
+     */
+    VecValue (const Lanes& startVals_, const Lanes& endVals_, int duration_,
+              Parametric::EasingFn easing_ =
+                  Parametric::getEasingFunction (Parametric::kLinear))
+    : startVals { startVals_ }
+    , endVals { endVals_ }
+    , currentVals { startVals_ }
+    , duration { duration_ }
+    , easing { easing_ }
+    {
+        jassert (duration > 0);
+        jassert (easing != nullptr);
+
+        for (std::size_t i = 0; i < LaneCount; ++i)
+            deltas[i] = endVals[i] - startVals[i];
+    }
+
+    /**
+     * @brief Calculate the values for this point in time.
+     *
+     * @param msElapsed time since this value started running.
+     * @return const Lanes& the current values.
+     */
+    const Lanes& getNextValue (int msElapsed)
+    {
+        if (msElapsed >= duration)
+            finished = true;
+
+        lastElapsed = msElapsed;
+        calculate (msElapsed, currentVals);
+        return currentVals;
+    }
+
+    /**
+     * @brief Calculate the values at a point in time without changing our state.
+     *
+     * @param msElapsed
+     * @param values array to fill.
+     */
+    void valueAt (int msElapsed, Lanes& values) const { calculate (msElapsed, values); }
+
+    /**
+     * @brief Go directly to a point in time, forward or backward.
+     *
+     * @param msElapsed
+     * @return the values at that time.
+     */
+    const Lanes& seek (int msElapsed)
+    {
+        finished    = msElapsed >= duration;
+        lastElapsed = msElapsed;
+        calculate (msElapsed, currentVals);
+        return currentVals;
+    }
+
+    /**
+     * @return true if we've reached the end of our duration or were canceled.
+     */
+    bool isFinished () const { return finished || canceled; }
+
+    /**
+     * @brief Cancel an in-progress value.
+     *
+     * @param moveToEndPosition if true, immediately take the end values.
+     */
+    void cancel (bool moveToEndPosition)
+    {
+        if (!canceled)
+        {
+            canceled = true;
+            if (moveToEndPosition)
+                currentVals = endVals;
+        }
+    }
+
+    /**
+     * @brief Change the end value of one lane while we're running. The rest of
+     * the lane's curve is re-scaled to run from where it is now to the new
+     * target, so it doesn't jump and still finishes on time. (If the curve is
+     * passing through its end point at the moment, e.g. an overshooting curve,
+     * the lane holds where it is and takes the new target when we finish.)
+     *
+     * @param lane
+     * @param newTarget
+     * @return false if the lane doesn't exist or we've already finished.
+     */
+    bool updateTarget (std::size_t lane, float newTarget)
+    {
+        if (lane >= LaneCount || isFinished ())
+            return false;
+
+        const auto curvePoint { getCurvePoint (lastElapsed) };
+        const auto current { startVals[lane] + curvePoint * deltas[lane] };
+        const auto remaining { 1.f - curvePoint };
+
+        endVals[lane] = newTarget;
+        deltas[lane]  = (std::abs (remaining) > kMinRemaining)
+                            ? (newTarget - current) / remaining
+                            : 0.f;
+        startVals[lane] = current - curvePoint * deltas[lane];
+        return true;
+    }
+
+    /**
+     * @brief Change the end values of all of our lanes.
+     *
+     * @param newTargets
+     * @return false if we've already finished.
+     */
+    bool updateTarget (const Lanes& newTargets)
+    {
+        if (isFinished ())
+            return false;
+
+        for (std::size_t i = 0; i < LaneCount; ++i)
+            updateTarget (i, newTargets[i]);
+        return true;
+    }
+
+    /**
+     * @brief Replace the easing curve used by all lanes.
+     *
+     * @param newEasing
+     */
+    void setEasing (Parametric::EasingFn newEasing)
+    {
+        jassert (newEasing != nullptr);
+        easing = newEasing;
+    }
+
+    const Lanes& getEndValue () const { return endVals; }
+
+    const Lanes& getCurrentValue () const { return currentVals; }
+
+    int getDuration () const { return duration; }
+
+private:
+    /**
+     * @return the position along our easing curve at a point in time.
+     */
+    float getCurvePoint (int msElapsed) const
+    {
+        const auto progress { static_cast<float> (std::max (0, msElapsed)) / duration };
+        return easing (std::min (1.f, progress));
+    }
+
+    void calculate (int msElapsed, Lanes& values) const
+    {
+        if (msElapsed >= duration)
+        {
+            values = endVals;
+            return;
+        }
+
+        // progress and curve are shared by every lane...
+        const auto curvePoint { getCurvePoint (msElapsed) };
+
+        // ...so each lane is a single multiply-add.
+        for (std::size_t i = 0; i < LaneCount; ++i)
+            values[i] = startVals[i] + curvePoint * deltas[i];
+    }
+
+private:
+    alignas (16) Lanes startVals;
+    alignas (16) Lanes deltas;
+    Lanes endVals;
+    Lanes currentVals;
+
+    /// @brief duration in ms.
+    int duration;
+    /// @brief time of the most recent update, in ms.
+    int lastElapsed { 0 };
+
+    /// @brief closer than this to the end of the curve, a lane can't be re-scaled.
+    static constexpr float kMinRemaining { 0.0001f };
+
+    /// @brief easing curve applied to all lanes.
+    Parametric::EasingFn easing;
+
+    bool canceled { false };
+    bool finished { false };
+};
+
+} // namespace friz
@@ -26,11 +26,24 @@
 #include "control/animator.cpp"
 #include "control/chain.cpp"
 #include "control/controller.cpp"
+#include "control/group.cpp"
+#include "control/pathAnimation.cpp"
+#include "control/repaintCoalescer.cpp"
 #include "control/sequence.cpp"
+#include "control/typedAnimation.cpp"
 #include "curves/animatedValue.cpp"
+#include "curves/colourTraits.cpp"
 #include "curves/constant.cpp"
+#include "curves/cubicBezier.cpp"
 #include "curves/easing.cpp"
+#include "curves/integrator.cpp"
+#include "curves/keyframe.cpp"
 #include "curves/linear.cpp"
 #include "curves/parametric.cpp"
+#include "curves/pathTable.cpp"
+#include "curves/sharedCurve.cpp"
 #include "curves/sinusoid.cpp"
 #include "curves/spring.cpp"
+#include "curves/track.cpp"
+#include "curves/valueTraits.cpp"
+#include "curves/vecValue.cpp"
@@ -46,11 +46,24 @@ END_JUCE_MODULE_DECLARATION
 #include "control/animator.h"
 #include "control/chain.h"
 #include "control/controller.h"
+#include "control/group.h"
+#include "control/pathAnimation.h"
+#include "control/repaintCoalescer.h"
 #include "control/sequence.h"
+#include "control/typedAnimation.h"
 #include "curves/animatedValue.h"
+#include "curves/colourTraits.h"
 #include "curves/constant.h"
+#include "curves/cubicBezier.h"
 #include "curves/easing.h"
+#include "curves/integrator.h"
+#include "curves/keyframe.h"
 #include "curves/linear.h"
 #include "curves/parametric.h"
+#include "curves/pathTable.h"
+#include "curves/sharedCurve.h"
 #include "curves/sinusoid.h"
 #include "curves/spring.h"
+#include "curves/track.h"
+#include "curves/valueTraits.h"
+#include "curves/vecValue.h"